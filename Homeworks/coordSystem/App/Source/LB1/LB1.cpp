@@ -1,73 +1,39 @@
 #include "LB1.h"
 
-#include <chrono>
-#include <random>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <string>
 
 #include "CoordinateSystems.h"
+#include "Benchmark/CoordinateBenchmarks.h"
+#include "Coordinates/Distance.h"
+#include "Core/ThreadPool.h"
 #include "imgui.h"
+#include "implot.h"
 #include "Core/Application.h"
 
-#define ARR_SIZE 100000
-
 namespace App
 {
-    template <typename T>
-    double distance2DCartesian(const CartesianPoint2D<T>& p1, const CartesianPoint2D<T>& p2)
+    namespace
     {
-        const double x = p2.getX() - p1.getX();
-        const double y = p2.getY() - p1.getY();
-        return std::sqrt(std::pow(x, 2) + std::pow(y, 2));
+        // Name prefixes of the case groups from makeCoordinateBenchmarks, in the order of LB1::m_groups
+        constexpr const char* kGroups[] { "convert/", "transform/", "reorder/", "generate/", "distance/", "matrix/" };
     }
 
-    template <typename T>
-    double distance3DCartesian(const CartesianPoint3D<T>& p1, const CartesianPoint3D<T>& p2)
-    {
-        const double x = p2.getX() - p1.getX();
-        const double y = p2.getY() - p1.getY();
-        const double z = p2.getZ() - p1.getZ();
-        return std::sqrt(std::pow(x, 2) + std::pow(y, 2) + std::pow(z, 2));
-    }
-
-    double distance2DPolar(const PolarPoint& p1, const PolarPoint& p2)
-    {
-        const double r1 = p1.getRadius();
-        const double r2 = p2.getRadius();
-        const double theta = p2.getTheta() - p1.getTheta();
-
-        return std::sqrt(std::pow(r1, 2) + std::pow(r2, 2) - 2 * r1 * r2 * std::cos(theta));
-    }
-
-
-    double distance3DChord(const SphericalPoint& p1, const SphericalPoint& p2)
-    {
-        const double r1 = p1.getRadius();
-        const double r2 = p2.getRadius();
-        const double theta1 = p1.getPolarAngle();
-        const double theta2 = p2.getPolarAngle();
-        const double phi1 = p1.getTheta();
-        const double phi2 = p2.getTheta();
-
-
-        return std::sqrt(std::pow(r1, 2) + std::pow(r2, 2) - 2 * r1 * r2 * (
-                         std::sin(theta1) * std::sin(theta2) * std::cos(phi1 - phi2)
-                         + std::cos(theta1) * std::cos(theta2)
-        ));
-    }
+    using Coord::distance2DCartesian;
+    using Coord::distance3DCartesian;
+    using Coord::distance2DPolar;
+    using Coord::distance3DChord;
+    using Coord::distance3DArc;
 
-    double distance3DArc(const SphericalPoint& p1, const SphericalPoint& p2)
+    // Formats into a buffer on the caller's stack, so logging doesn't allocate a std::string
+    template <typename Point, std::size_t N>
+    const char* formatPoint(char (&buffer)[N], const Point& p)
     {
-        const double radius = (p1.getRadius() + p2.getRadius()) / 2.0;
-
-        const double phi1 = p1.getPolarAngle();
-        const double phi2 = p2.getPolarAngle();
-        const double theta1 = p1.getTheta();
-        const double theta2 = p2.getTheta();
-
-        return radius * std::acos(
-            std::sin(phi1) * std::sin(phi2)
-            * std::cos(theta1 - theta2)
-            + std::cos(phi1) * std::cos(phi2)
-        );
+        const auto result { std::format_to_n(buffer, N - 1, "{:.2f}", p) };
+        *result.out = '\0';
+        return buffer;
     }
 
     void firstPart2D()
@@ -76,13 +42,12 @@ namespace App
         const CartesianPoint2D<double> cart2D {5.5, 24.1};
         const PolarPoint pol2D { PolarPoint::fromCartesian(cart2D) };
 
-        IMGUI_DEBUG_LOG("%s", CartesianPoint2D<double>::GetDataAsString(cart2D).c_str());
-        IMGUI_DEBUG_LOG("%s", PolarPoint::GetDataAsString(pol2D).c_str());
+        char buffer[128];
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, cart2D));
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, pol2D));
 
-        IMGUI_DEBUG_LOG("%s", CartesianPoint2D<double>::GetDataAsString(
-            CartesianPoint2D<double>::fromPolar(pol2D)
-        ).c_str());
-        IMGUI_DEBUG_LOG("%s", PolarPoint::GetDataAsString(pol2D).c_str());
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, CartesianPoint2D<double>::fromPolar(pol2D)));
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, pol2D));
     }
 
     void firstPart3D()
@@ -91,13 +56,12 @@ namespace App
         const CartesianPoint3D<double> cart3D {5.5, 24.1, 55};
         const SphericalPoint pol3D { SphericalPoint::fromCartesian(cart3D) };
 
-        IMGUI_DEBUG_LOG("%s\n", CartesianPoint3D<double>::GetDataAsString(cart3D).c_str());
-        IMGUI_DEBUG_LOG("%s\n", SphericalPoint::GetDataAsString(pol3D).c_str());
+        char buffer[128];
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, cart3D));
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, pol3D));
 
-        IMGUI_DEBUG_LOG("%s\n", CartesianPoint3D<double>::GetDataAsString(
-            CartesianPoint3D<double>::fromSpherical(pol3D)
-            ).c_str());
-        IMGUI_DEBUG_LOG("%s\n\n", SphericalPoint::GetDataAsString(pol3D).c_str());
+        IMGUI_DEBUG_LOG("%s\n", formatPoint(buffer, CartesianPoint3D<double>::fromSpherical(pol3D)));
+        IMGUI_DEBUG_LOG("%s\n\n", formatPoint(buffer, pol3D));
     }
 
     void secondPart2D()
@@ -123,162 +87,170 @@ namespace App
         IMGUI_DEBUG_LOG("3D Cartesian distance:     %f\n\n", distance3DCartesian(c1, c2));
     }
 
-    template <std::size_t N>
-    void gen2DPolarData(std::vector<PolarPoint>& p1, std::vector<PolarPoint>& p2, std::mt19937& mt)
+    void LB1::OnAttach()
     {
-        std::uniform_real_distribution<double> range{0.0, 100.0};
-
-        p1.clear();
-        p2.clear();
-        p1.reserve(N);
-        p2.reserve(N);
+        IMGUI_DEBUG_LOG("FIRST PART\n");
 
-        for (std::size_t i = 0; i < N; ++i)
-        {
-            p1.emplace_back(range(mt), range(mt));
-            p2.emplace_back(range(mt), range(mt));
-        }
-    }
+        firstPart2D();
+        std::cout << std::endl;
+        firstPart3D();
 
-    template <std::size_t N>
-    void polarToCartesian2D(const std::vector<PolarPoint>& p, std::vector<CartesianPoint2D<double>>& c)
-    {
-        c.clear();
-        c.reserve(N);
-        for (std::size_t i = 0; i < N; ++i)
-            c.emplace_back(CartesianPoint2D<double>::fromPolar(p[i]));
-    }
+        IMGUI_DEBUG_LOG("SECOND PART\n");
 
-    void thirdPart2D(std::mt19937& mt)
-    {
-        std::vector<PolarPoint> p1, p2;
-        gen2DPolarData<ARR_SIZE>(p1, p2, mt);
+        secondPart2D();
+        std::cout << std::endl;
+        secondPart3D();
 
-        std::vector<CartesianPoint2D<double>> c1, c2;
-        polarToCartesian2D<ARR_SIZE>(p1, c1);
-        polarToCartesian2D<ARR_SIZE>(p2, c2);
+        IMGUI_DEBUG_LOG("THIRD PART\n");
+        IMGUI_DEBUG_LOG("Benchmarks run in the background, see the LB1 Benchmarks window\n\n");
 
-        IMGUI_DEBUG_LOG("2D benchmark\n");
+        StartBenchmarks();
+    }
 
-        // A POLAR
+    void LB1::OnUpdate()
+    {
+        m_runner.CopyNewResults(m_results);
+        for (; m_loggedResults < m_results.size(); ++m_loggedResults)
         {
-            const auto start = std::chrono::high_resolution_clock::now();
-            for (std::size_t i = 0; i < ARR_SIZE; ++i)
-                distance2DPolar(p1[i], p2[i]);
-
-            const auto end = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            IMGUI_DEBUG_LOG("Polar: %ld ms\n", duration.count());
+            const Bench::Result& result { m_results[m_loggedResults] };
+            IMGUI_DEBUG_LOG("%-28s median %8.1f us, p99 %8.1f us, %6.2f ns/op\n", result.name.c_str(),
+                            result.stats.medianNs / 1.0e3, result.stats.p99Ns / 1.0e3, result.nsPerItem());
         }
 
-        // B CARTESIAN
+        if (!m_exported && !m_runner.GetProgress().running)
         {
-            const auto start = std::chrono::high_resolution_clock::now();
-            for (std::size_t i = 0; i < ARR_SIZE; ++i)
-                distance2DCartesian(c1[i], c2[i]);
-
-            const auto end = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            IMGUI_DEBUG_LOG("Cartesian: %ld ms\n", duration.count());
+            // The last results may have arrived after the copy above
+            m_runner.CopyNewResults(m_results);
+            if (m_loggedResults == m_results.size())
+            {
+                ExportResults();
+                m_exported = true;
+            }
         }
     }
 
-    template <std::size_t N>
-    void gen3DSphericalData(std::vector<SphericalPoint>& s1, std::vector<SphericalPoint>& s2, std::mt19937& mt)
+    void LB1::OnImGuiRender()
     {
-        std::uniform_real_distribution<double> range{0.0, 100.0};
+        ImGui::ShowDebugLogWindow();
 
-        s1.clear();
-        s2.clear();
-        s1.reserve(N);
-        s2.reserve(N);
+        ImGui::Begin("LB1 Benchmarks", nullptr, ImGuiWindowFlags_NoCollapse);
 
-        for (std::size_t i = 0; i < N; ++i)
-        {
-            double radius = range(mt);
-            s1.emplace_back(radius, range(mt), range(mt));
-            s2.emplace_back(radius, range(mt), range(mt));
-        }
-    }
+        BenchmarkSettings();
+        ImGui::Separator();
+        BenchmarkProgress();
+        ImGui::Separator();
+        ResultsChart();
 
-    template <std::size_t N>
-    void sphericalToCartesian3D(const std::vector<SphericalPoint>& s, std::vector<CartesianPoint3D<double>>& c)
-    {
-        c.clear();
-        c.reserve(N);
-        for (std::size_t i = 0; i < N; ++i)
-            c.emplace_back(CartesianPoint3D<double>::fromSpherical(s[i]));
+        ImGui::End();
     }
 
-    void thirdPart3D(std::mt19937& mt)
+    void LB1::StartBenchmarks()
     {
-        std::vector<SphericalPoint> s1, s2;
-        gen3DSphericalData<ARR_SIZE>(s1, s2, mt);
-
-        std::vector<CartesianPoint3D<double>> c1, c2;
-        sphericalToCartesian3D<ARR_SIZE>(s1, c1);
-        sphericalToCartesian3D<ARR_SIZE>(s2, c2);
+        m_results.clear();
+        m_loggedResults = 0;
+        m_exported = false;
+        m_environment = Bench::currentEnvironment();
 
-        IMGUI_DEBUG_LOG("3D benchmark\n");
+        const std::size_t size { static_cast<std::size_t>(m_size) };
+        const std::size_t threads { static_cast<std::size_t>(m_threads) };
+        const std::string filter { m_filter };
+        const std::vector<bool> groups(std::begin(m_groups), std::end(m_groups));
 
-        // A chord
+        m_runner.Start([size, threads]
         {
-            const auto start = std::chrono::high_resolution_clock::now();
-            for (std::size_t i = 0; i < ARR_SIZE; ++i)
-                distance3DChord(s1[i], s2[i]);
+            return Bench::makeCoordinateBenchmarks(size, 42, threads);
+        }, { .warmupRuns = 1, .repetitions = static_cast<std::size_t>(m_repetitions) },
+        [filter, groups](const Bench::Case& benchmark)
+        {
+            bool selected { false };
+            for (std::size_t i = 0; i < groups.size(); ++i)
+                selected = selected || (groups[i] && benchmark.name.starts_with(kGroups[i]));
+            return selected && benchmark.name.find(filter) != std::string::npos;
+        });
+    }
 
-            const auto end = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            IMGUI_DEBUG_LOG("Chord: %ld ms\n", duration.count());
-        }
+    // The results also go to LB1Benchmarks.json and .csv in the working directory, for coordSystemBenchCompare
+    void LB1::ExportResults() const
+    {
+        if (m_results.empty())
+            return;
+
+        const Bench::Report report { m_environment, m_results };
+        std::ofstream json { "LB1Benchmarks.json" };
+        Bench::writeJson(json, report);
+        std::ofstream csv { "LB1Benchmarks.csv" };
+        Bench::writeCsv(csv, report);
+        IMGUI_DEBUG_LOG(json && csv ? "Results written to LB1Benchmarks.json and LB1Benchmarks.csv\n"
+                                    : "Failed to write LB1Benchmarks.json or LB1Benchmarks.csv\n");
+    }
 
-        // B Arc
-        {
-            const auto start = std::chrono::high_resolution_clock::now();
-            for (std::size_t i = 0; i < ARR_SIZE; ++i)
-                distance3DArc(s1[i], s2[i]);
+    void LB1::BenchmarkSettings()
+    {
+        ImGui::BeginDisabled(m_runner.GetProgress().running);
 
-            const auto end = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            IMGUI_DEBUG_LOG("Arc: %ld ms\n", duration.count());
-        }
+        ImGui::InputInt("Points", &m_size, 10000, 100000);
+        m_size = std::max(m_size, 1);
+        ImGui::SliderInt("Repetitions", &m_repetitions, 1, 100);
+        ImGui::SliderInt("Threads (0 = all)", &m_threads, 0, static_cast<int>(Core::ThreadPool::Get().GetThreadCount()));
 
-        // C Cartesian
+        for (std::size_t i = 0; i < std::size(kGroups); ++i)
         {
-            const auto start = std::chrono::high_resolution_clock::now();
-            for (std::size_t i = 0; i < ARR_SIZE; ++i)
-                distance3DCartesian(c1[i], c2[i]);
-
-            const auto end = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            IMGUI_DEBUG_LOG("Cartesian: %ld ms\n", duration.count());
+            if (i > 0)
+                ImGui::SameLine();
+            ImGui::Checkbox(kGroups[i], &m_groups[i]);
         }
+        ImGui::InputText("Name contains", m_filter, sizeof(m_filter));
+
+        ImGui::EndDisabled();
     }
 
-    void LB1::OnAttach()
+    void LB1::BenchmarkProgress()
     {
-        IMGUI_DEBUG_LOG("FIRST PART\n");
+        const Bench::BackgroundRunner::Progress progress { m_runner.GetProgress() };
 
-        firstPart2D();
-        std::cout << std::endl;
-        firstPart3D();
+        if (progress.running)
+        {
+            if (ImGui::Button("Cancel"))
+                m_runner.Cancel();
+        }
+        else if (ImGui::Button("Run"))
+            StartBenchmarks();
 
-        IMGUI_DEBUG_LOG("SECOND PART\n");
+        std::string status;
+        if (progress.running)
+            status = progress.total == 0 ? "Preparing data" : std::format("{} ({}/{})", progress.current, progress.completed + 1, progress.total);
+        else
+            status = progress.cancelled ? "Cancelled" : "Done";
 
-        secondPart2D();
-        std::cout << std::endl;
-        secondPart3D();
-
-        IMGUI_DEBUG_LOG("THIRD PART\n");
+        ImGui::SameLine();
+        const float fraction { progress.total == 0 ? 0.0f : static_cast<float>(progress.completed) / static_cast<float>(progress.total) };
+        ImGui::ProgressBar(progress.running ? fraction : 1.0f, ImVec2(-1, 0), status.c_str());
 
-        std::mt19937 mt{ std::random_device{}() };
-        thirdPart2D(mt);
-        std::cout << std::endl;
-        thirdPart3D(mt);
+        if (!progress.error.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Error: %s", progress.error.c_str());
     }
 
-    void LB1::OnImGuiRender()
+    // ns/op of every result so far, one horizontal bar each
+    void LB1::ResultsChart() const
     {
-        ImGui::ShowDebugLogWindow();
+        if (m_results.empty())
+            return;
+
+        std::vector<double> nsPerItem, positions;
+        std::vector<const char*> names;
+        for (const Bench::Result& result : m_results)
+        {
+            positions.push_back(static_cast<double>(positions.size()));
+            nsPerItem.push_back(result.nsPerItem());
+            names.push_back(result.name.c_str());
+        }
+
+        if (ImPlot::BeginPlot("ns/op", ImVec2(-1, -1)))
+        {
+            ImPlot::SetupAxes("ns/op", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_Invert);
+            ImPlot::SetupAxisTicks(ImAxis_Y1, positions.data(), static_cast<int>(positions.size()), names.data());
+            ImPlot::PlotBars("ns/op", nsPerItem.data(), static_cast<int>(nsPerItem.size()), 0.67, 0, ImPlotBarsFlags_Horizontal);
+            ImPlot::EndPlot();
+        }
     }
 }
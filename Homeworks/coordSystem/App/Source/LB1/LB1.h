@@ -1,6 +1,10 @@
 #ifndef COORDSYSTEM_LB1_H
 #define COORDSYSTEM_LB1_H
 
+#include <vector>
+
+#include "Benchmark/BackgroundRunner.h"
+#include "Benchmark/Report.h"
 #include "Core/Layer.h"
 
 namespace App
@@ -13,11 +17,31 @@ namespace App
         ~LB1() override = default;
 
         void OnAttach() override;
+        void OnUpdate() override;
         void OnImGuiRender() override;
     private:
-        bool m_running = true;
+        void StartBenchmarks();
+        void ExportResults() const;
+        void BenchmarkSettings();
+        void BenchmarkProgress();
+        void ResultsChart() const;
+    private:
+        // Benchmarks run on the runner's thread, the layer only shows what it finished so far
+        Bench::BackgroundRunner m_runner;
+        std::vector<Bench::Result> m_results;
+        std::size_t m_loggedResults{ 0 };
+        Bench::Environment m_environment;
+        bool m_exported{ true };
+
+        int m_size{ 100000 };
+        int m_repetitions{ 10 };
+        // 0 uses every thread of the pool
+        int m_threads{ 0 };
+        // Which of the groups of makeCoordinateBenchmarks run, see kGroups
+        bool m_groups[6]{ false, false, false, false, true, false };
+        char m_filter[64]{ "/exact" };
     };
 }
 
 
-#endif //COORDSYSTEM_LB1_H
\ No newline at end of file
+#endif //COORDSYSTEM_LB1_H
@@ -1,10 +1,12 @@
 #include "LB2.h"
 
 #include <iostream>
+#include <ranges>
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;            // from <nlohmann/json.hpp>
 
 #include "CoordinateSystems.h"
+#include "Coordinates/Views.h"
 #include "imgui.h"
 #include "Core/Application.h"
 
@@ -15,7 +17,24 @@ using json = nlohmann::json;            // from <nlohmann/json.hpp>
 
 namespace App
 {
-    void LB2::HandleMessage(const std::string& msg)
+    namespace
+    {
+        // Echoes shown at once
+        constexpr std::size_t kShownEchoes { 10 };
+
+        PolarPoint toPolar(const LB2::DockerData& data)
+        {
+            return PolarPoint{ data.distanceKm, data.angle * (PI / 180.0) };
+        }
+
+        ImVec4 powerColor(const double power)
+        {
+            const float p { static_cast<float>(power) };
+            return { 1.0f - p, p, 0.0f, 1.0f };
+        }
+    }
+
+    void LB2::HandleMessage(const std::string_view msg)
     {
         try
         {
@@ -42,19 +61,22 @@ namespace App
                 throw std::runtime_error("echoResponse isn't an array");
 
 
-            std::lock_guard<std::mutex> lock(m_mtx);
             for (auto& echo : echoes)
             {
                 double time = echo["time"];
                 double power = echo["power"];
                 double distanceKm = LIGHTSPEED * time / 2.0;
 
+                m_recentEchoes.push_back( {scanAngle, power, distanceKm} );
+            }
 
-                m_data.push_back( {scanAngle, power, distanceKm} );
+            if (m_recentEchoes.size() > kShownEchoes)
+                m_recentEchoes.erase(m_recentEchoes.begin(), m_recentEchoes.end() - kShownEchoes);
 
-                if (m_data.size() > 10)
-                    m_data.pop_front();
-            }
+            // A frame that takes longer than a few scans skips the windows in between, never the newest one
+            std::vector<DockerData>& published { m_echoes.GetWriteBuffer() };
+            published.assign(m_recentEchoes.begin(), m_recentEchoes.end());
+            m_echoes.Publish();
         }
         catch (std::exception& e)
         {
@@ -64,10 +86,16 @@ namespace App
 
     LB2::LB2()
     {
-        websocket = std::make_unique<WebSocketClient>("127.0.0.1", "4000", [this](const std::string& msg)
+        websocket = std::make_unique<WebSocketClient>(WebSocketContext::Get(), "127.0.0.1", "4000", [this](const std::string_view msg)
         {
             HandleMessage(msg);
         });
+
+        // The feed is bandwidth bound. A server that batches scans sends them as a JSON array, single scans still work
+        WebSocketClient::ConnectionOptions options { websocket->GetOptions() };
+        options.permessageDeflate = true;
+        options.framing = WebSocketClient::Framing::JsonArray;
+        websocket->SetOptions(options);
     }
 
     LB2::~LB2()
@@ -79,8 +107,13 @@ namespace App
     {
         Layer::OnUpdate();
 
-        std::lock_guard<std::mutex> lock(m_mtx);
-        m_dataCopy = m_data;
+        // The index is only rebuilt when echoes came in
+        if (!m_echoes.Update())
+            return;
+
+        m_targetIndex.clear();
+        for (const CartesianPoint2D<double>& target : m_echoes.GetReadBuffer() | std::views::transform(toPolar) | Coord::views::to_cartesian)
+            m_targetIndex.insert(target);
     }
 
     void LB2::OnImGuiRender()
@@ -96,22 +129,9 @@ namespace App
 
         ImGui::Separator();
 
-        // Is this part of code bad? Yes
-        // Should I fix it? Definitely yes
-        // Will I do it? Absolutely not
-        std::vector<double> x_coords;
-        std::vector<double> y_coords;
-
-        for (const auto& data : m_dataCopy)
-        {
-            const double angleRad = data.angle * (PI / 180.0);
-
-            PolarPoint polar(data.distanceKm, angleRad);
-            CartesianPoint2D<double> cartesian = CartesianPoint2D<double>::fromPolar(polar);
-
-            x_coords.push_back(cartesian.getX());
-            y_coords.push_back(cartesian.getY());
-        }
+        // Targets are converted while the plot iterates them, no coordinate buffers in between
+        const std::vector<DockerData>& echoes { m_echoes.GetReadBuffer() };
+        auto targets { echoes | std::views::transform(toPolar) | Coord::views::to_cartesian };
 
         if (ImPlot::BeginPlot("Radar", ImVec2(-1, -1), ImPlotFlags_Equal))
         {
@@ -119,34 +139,30 @@ namespace App
             ImPlot::SetupAxisLimits(ImAxis_X1, -RADAR_RANGE, RADAR_RANGE);
             ImPlot::SetupAxisLimits(ImAxis_Y1, -RADAR_RANGE, RADAR_RANGE);
 
-            if (!x_coords.empty())
+            for (const auto& [data, cartesian] : std::views::zip(echoes, targets))
             {
-                std::size_t i{ 0 };
-                for (const auto& data : m_dataCopy)
+                const double x { cartesian.getX() };
+                const double y { cartesian.getY() };
+                const ImVec4 color { powerColor(data.power) };
+
+                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, color, IMPLOT_AUTO, color);
+                ImPlot::PlotScatter("target", &x, &y, 1);
+            }
+
+            if (ImPlot::IsPlotHovered())
+            {
+                const ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+                constexpr double hover_radius { 5.0 };
+
+                m_targetIndex.withinRadius({ mouse.x, mouse.y }, hover_radius, m_hoveredTargets);
+                for (const std::size_t i : m_hoveredTargets)
                 {
-                    const float power { static_cast<float>(data.power) };
-                    ImVec4 color { 1.0f - power, power, 0.0f, 1.0f };
-
-                    ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, color, IMPLOT_AUTO, color);
-                    ImPlot::PlotScatter("target", &x_coords[i], &y_coords[i], 1);
-
-                    if (ImPlot::IsPlotHovered())
-                    {
-                        const ImPlotPoint mouse = ImPlot::GetPlotMousePos();
-                        const double dx { x_coords[i] - mouse.x };
-                        const double dy { y_coords[i] - mouse.y };
-                        const double distanceToCenter { std::sqrt(dx*dx + dy*dy) };
-                        constexpr double hover_radius { 5.0 };
-
-                        if (distanceToCenter < hover_radius)
-                        {
-                            ImPlot::Annotation(x_coords[i], y_coords[i], color, ImVec2(10,10), false,
-                            "Angle: %d°\nPower: %.2f\nDistance: %.2f km",
-                            data.angle, data.power, data.distanceKm);
-                        }
-                    }
-
-                    ++i;
+                    const DockerData& data { echoes[i] };
+                    const CartesianPoint2D<double>& target { m_targetIndex[i] };
+
+                    ImPlot::Annotation(target.getX(), target.getY(), powerColor(data.power), ImVec2(10,10), false,
+                    "Angle: %d°\nPower: %.2f\nDistance: %.2f km",
+                    data.angle, data.power, data.distanceKm);
                 }
             }
 
@@ -1,7 +1,12 @@
 #ifndef COORDSYSTEM_LB2_H
 #define COORDSYSTEM_LB2_H
 
+#include <vector>
+
+#include "CoordinateSystems.h"
 #include "Core/Layer.h"
+#include "Core/TripleBuffer.h"
+#include "Coordinates/SpatialIndex.h"
 #include "WebSocketClient.h"
 
 namespace App
@@ -24,18 +29,24 @@ namespace App
     private:
         void ChangeParameters();
         void WebSocketButton();
-        void HandleMessage(const std::string& msg);
+        void HandleMessage(std::string_view msg);
     private:
         int measurementsPerRotation { 360 };
         int rotationSpeed { 60 };
         int targetSpeed { 100 };
     private:
         std::unique_ptr<WebSocketClient> websocket;
-        std::list<DockerData> m_data;
-        std::list<DockerData> m_dataCopy;
+        // Only touched by the websocket callback
         int m_lastAngle{-1};
+        std::vector<DockerData> m_recentEchoes;
+
+        // The most recent echoes, published by the websocket callback after every scan.
+        // The only state it shares with the render thread
+        Core::TripleBuffer<std::vector<DockerData>> m_echoes;
 
-        mutable std::mutex m_mtx;
+        // Cartesian targets, the handles are positions in the read buffer of m_echoes
+        Coord::UniformGrid<CartesianPoint2D<double>> m_targetIndex{10.0};
+        std::vector<std::size_t> m_hoveredTargets;
     };
 }
 
@@ -10,6 +10,7 @@
 using json = nlohmann::json;            // from <nlohmann/json.hpp>
 
 #include <chrono>
+#include <cmath>
 
 uint64_t getUnixTimeMs() {
     return static_cast<uint64_t>(
@@ -21,7 +22,14 @@ uint64_t getUnixTimeMs() {
 
 namespace App
 {
-    void LB3::HandleMessage(const std::string& msg)
+    namespace
+    {
+        constexpr ImVec4 kSatelliteColor { 0.2f, 0.2f, 0.5f, 1.0f };
+        constexpr ImVec4 kAnalyticalColor { 0.7f, 0.2f, 0.2f, 1.0f };
+        constexpr ImVec4 kNumericalColor { 0.2f, 0.7f, 0.3f, 1.0f };
+    }
+
+    void LB3::HandleMessage(const std::string_view msg)
     {
         try
         {
@@ -38,7 +46,6 @@ namespace App
             }
 
 
-            const std::string id = j["id"];
             SatelliteData data
             {
                 j["x"],
@@ -47,23 +54,10 @@ namespace App
                 j["receivedAt"]
             };
 
-
-            std::lock_guard<std::mutex> lock(m_mtx);
-
-            const auto it = std::ranges::find_if(m_satellitesData,
-                                                 [&id](const auto& p){ return p.first == id; });
-
-            if (it != m_satellitesData.end())
-            {
-                it->second = data;
-            }
-            else
-            {
-                m_satellitesData.emplace_back(id, data);
-
-                if (m_satellitesData.size() > 3)
-                    m_satellitesData.erase(m_satellitesData.begin());
-            }
+            // Only full when OnUpdate is over a thousand messages behind, the satellite then
+            // stays where it was until its next message
+            if (!m_updates.TryPush({ j["id"].get<std::string>(), data }))
+                std::cerr << "Satellite update dropped, the render thread is behind\n";
         }
         catch (std::exception& e)
         {
@@ -73,10 +67,10 @@ namespace App
 
     std::optional<LB3::ObjectPosition> LB3::CalculateAnalytical()
     {
-        if (m_satellitesDataCopy.size() < 3)
+        if (m_satellites.size() < 3)
             return std::nullopt;
 
-        auto it = m_satellitesDataCopy.begin();
+        auto it = m_satellites.begin();
         SatelliteData s1 = it->second;
         ++it;
         SatelliteData s2 = it->second;
@@ -112,13 +106,13 @@ namespace App
 
     std::optional<LB3::ObjectPosition> LB3::CalculateNumerical()
     {
-        if (m_satellitesDataCopy.size() < 3)
+        if (m_satellites.size() < 3)
             return std::nullopt;
 
         auto gradient = [this](float x, float y)
         {
             float gx = 0.0f, gy = 0.0f;
-            for (const auto& [id, sat] : m_satellitesDataCopy)
+            for (const auto& [id, sat] : m_satellites)
             {
                 const float dx = x - sat.x;
                 const float dy = y - sat.y;
@@ -183,7 +177,7 @@ namespace App
 
     LB3::LB3()
     {
-        websocket = std::make_unique<WebSocketClient>("127.0.0.1", "4001", [this](const std::string& msg)
+        websocket = std::make_unique<WebSocketClient>(WebSocketContext::Get(), "127.0.0.1", "4001", [this](const std::string_view msg)
         {
             HandleMessage(msg);
         });
@@ -196,12 +190,58 @@ namespace App
 
     void LB3::OnUpdate()
     {
-        std::unique_lock<std::mutex> lock(m_mtx);
-        m_satellitesDataCopy = m_satellitesData;
-        lock.unlock();
+        const std::size_t updates { m_updates.ConsumeAll([this](SatelliteUpdate&& update)
+        {
+            const auto it = std::ranges::find_if(m_satellites,
+                                                 [&update](const auto& p){ return p.first == update.id; });
+
+            if (it != m_satellites.end())
+            {
+                it->second = update.data;
+            }
+            else
+            {
+                m_satellites.emplace_back(std::move(update.id), update.data);
+
+                if (m_satellites.size() > 3)
+                    m_satellites.erase(m_satellites.begin());
+            }
+        }) };
+
+        // Positions and markers only change with the satellites
+        if (updates == 0)
+            return;
 
         m_analyticalPosition = CalculateAnalytical();
         m_numericalPosition = CalculateNumerical();
+
+        UpdateMarkerIndex();
+    }
+
+    void LB3::UpdateMarkerIndex()
+    {
+        // Handles count up from 0 after clear(), so they line up with the colors
+        m_markerIndex.clear();
+        m_markerColors.clear();
+
+        // A bad message or a solver that didn't converge gives NaN or infinite positions, they have no place to hover
+        const auto addMarker = [this](const float x, const float y, const ImVec4& color)
+        {
+            if (!std::isfinite(x) || !std::isfinite(y))
+                return;
+
+            m_markerIndex.insert({ x, y });
+            m_markerColors.push_back(color);
+        };
+
+        for (const auto& [id, sat] : m_satellites)
+            addMarker(sat.x, sat.y, kSatelliteColor);
+
+        if (m_analyticalPosition)
+            addMarker(m_analyticalPosition->x, m_analyticalPosition->y, kAnalyticalColor);
+
+        if (m_numericalPosition)
+            addMarker(m_numericalPosition->x, m_numericalPosition->y, kNumericalColor);
     }
 
     void LB3::ChangeParameters()
@@ -236,7 +276,7 @@ namespace App
 
             std::vector<float> sat_x, sat_y;
             std::vector<std::string> sat_ids;
-            for (const auto& [id, sat] : m_satellitesDataCopy) {
+            for (const auto& [id, sat] : m_satellites) {
                 sat_x.push_back(sat.x);
                 sat_y.push_back(sat.y);
                 sat_ids.push_back(id);
@@ -244,12 +284,8 @@ namespace App
 
             if (!sat_x.empty())
             {
-                constexpr ImVec4 color { 0.2f, 0.2f, 0.5f, 1.0f};
-                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, color, IMPLOT_AUTO, color);
+                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, kSatelliteColor, IMPLOT_AUTO, kSatelliteColor);
                 ImPlot::PlotScatter("Satellites", sat_x.data(), sat_y.data(), static_cast<int>(sat_x.size()));
-
-                for (std::size_t i = 0; i < sat_x.size(); ++i)
-                    OnImPlotHover(sat_x[i], sat_y[i], color);
             }
 
             if (m_analyticalPosition.has_value())
@@ -257,10 +293,8 @@ namespace App
                 const float x = m_analyticalPosition->x;
                 const float y = m_analyticalPosition->y;
 
-                constexpr ImVec4 color { 0.7f, 0.2f, 0.2f, 1.0f};
-                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, color, IMPLOT_AUTO, color);
+                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, kAnalyticalColor, IMPLOT_AUTO, kAnalyticalColor);
                 ImPlot::PlotScatter("Analytical", &x, &y, 1);
-                OnImPlotHover(x, y, color);
             }
 
             if (m_numericalPosition.has_value())
@@ -268,30 +302,30 @@ namespace App
                 const float x = m_numericalPosition->x;
                 const float y = m_numericalPosition->y;
 
-                constexpr ImVec4 color { 0.2f, 0.7f, 0.3f, 1.0f};
-                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, color, IMPLOT_AUTO, color);
+                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 5, kNumericalColor, IMPLOT_AUTO, kNumericalColor);
                 ImPlot::PlotScatter("Numerical", &x, &y, 1);
-                OnImPlotHover(x, y, color);
             }
 
+            OnImPlotHover();
+
             ImPlot::EndPlot();
         }
     }
 
-    void LB3::OnImPlotHover(const float x, const float y, const ImVec4 color)
+    void LB3::OnImPlotHover()
     {
         if (ImPlot::IsPlotHovered())
         {
             const ImPlotPoint mouse { ImPlot::GetPlotMousePos() };
-            const double dx { mouse.x - x };
-            const double dy { mouse.y - y };
-            const double distanceToCenter { std::sqrt(dx*dx + dy*dy) };
-            constexpr double hover_radius { 5.0 };
+            const CartesianPoint2D<float> mousePoint { static_cast<float>(mouse.x), static_cast<float>(mouse.y) };
+            constexpr float hover_radius { 5.0f };
 
-            if (distanceToCenter < hover_radius)
+            m_markerIndex.withinRadius(mousePoint, hover_radius, m_hoveredMarkers);
+            for (const std::size_t i : m_hoveredMarkers)
             {
-                ImPlot::Annotation(x, y, color, ImVec2(10,10), false,
-                "X: %.2f\nY: %.2f km", x, y);
+                const CartesianPoint2D<float>& marker { m_markerIndex[i] };
+                ImPlot::Annotation(marker.x, marker.y, m_markerColors[i], ImVec2(10,10), false,
+                "X: %.2f\nY: %.2f km", marker.x, marker.y);
             }
         }
     }
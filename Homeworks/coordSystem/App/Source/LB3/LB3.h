@@ -1,7 +1,10 @@
 #ifndef COORDSYSTEM_LB3_H
 #define COORDSYSTEM_LB3_H
 
+#include "CoordinateSystems.h"
 #include "Core/Layer.h"
+#include "Core/SpscRingBuffer.h"
+#include "Coordinates/SpatialIndex.h"
 #include "WebSocketClient.h"
 
 #include "imgui.h"
@@ -43,8 +46,9 @@ namespace App
         void WebSocketButton();
         void ChangeParameters();
         void ShowGPS();
-        void OnImPlotHover(const float x, const float y, const ImVec4 color = { 0.0f, 0.0f, 0.0f, 1.0f });
-        void HandleMessage(const std::string& msg);
+        void UpdateMarkerIndex();
+        void OnImPlotHover();
+        void HandleMessage(std::string_view msg);
 
         /**
         * @param Використовується трилитерація
@@ -60,14 +64,28 @@ namespace App
         int messageFrequency { 1 };
         int satelliteSpeed { 120 };
         int objectSpeed { 20 };
-        std::vector<std::pair<std::string, SatelliteData>> m_satellitesData;
-        std::vector<std::pair<std::string, SatelliteData>> m_satellitesDataCopy;
+        struct SatelliteUpdate
+        {
+            std::string id;
+            SatelliteData data;
+        };
+        // Every message moves one satellite, so none may be skipped on the way from the websocket
+        // callback to OnUpdate. The only state the two share
+        Core::SpscRingBuffer<SatelliteUpdate, 1024> m_updates;
+
+        using Satellites = std::vector<std::pair<std::string, SatelliteData>>;
+        // The three most recent satellites, only touched by the render thread
+        Satellites m_satellites;
 
         std::optional<ObjectPosition> m_analyticalPosition;
         std::optional<ObjectPosition> m_numericalPosition;
 
+        // Satellites and both positions as plotted, the handles index m_markerColors
+        Coord::UniformGrid<CartesianPoint2D<float>> m_markerIndex{10.0f};
+        std::vector<ImVec4> m_markerColors;
+        std::vector<std::size_t> m_hoveredMarkers;
+
         std::unique_ptr<WebSocketClient> websocket;
-        mutable std::mutex m_mtx;
     };
 }
 
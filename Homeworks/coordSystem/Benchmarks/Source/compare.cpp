@@ -0,0 +1,114 @@
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "Benchmark/Report.h"
+
+// Compares two result files of coordSystemBenchmarks --json. Exits with 2 if anything got slower,
+// so a CI job on the perf lab machines can fail on it.
+namespace
+{
+    struct Arguments
+    {
+        std::string_view baselinePath;
+        std::string_view currentPath;
+        Bench::CompareOptions options;
+        // Print only the results that changed
+        bool changedOnly{ false };
+    };
+
+    void printUsage(const char* program)
+    {
+        std::cout << "Usage: " << program << " BASELINE.json CURRENT.json [--alpha P] [--threshold FRACTION] [--changed]\n";
+    }
+
+    bool parseNumber(const std::string_view text, double& value)
+    {
+        const auto [end, ec] { std::from_chars(text.data(), text.data() + text.size(), value) };
+        return ec == std::errc{} && end == text.data() + text.size();
+    }
+
+    bool parseArguments(const int argc, char** argv, Arguments& arguments)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view option { argv[i] };
+            bool valid { true };
+            if (option == "--changed")
+                arguments.changedOnly = true;
+            else if (option == "--alpha" && i + 1 < argc)
+                valid = parseNumber(argv[++i], arguments.options.alpha);
+            else if (option == "--threshold" && i + 1 < argc)
+                valid = parseNumber(argv[++i], arguments.options.threshold);
+            else if (arguments.baselinePath.empty())
+                arguments.baselinePath = option;
+            else if (arguments.currentPath.empty())
+                arguments.currentPath = option;
+            else
+                valid = false;
+
+            if (!valid)
+                return false;
+        }
+        return !arguments.currentPath.empty();
+    }
+
+    std::optional<Bench::Report> load(const std::string_view path)
+    {
+        std::ifstream file { std::string(path) };
+        auto report { file ? Bench::readJson(file) : std::nullopt };
+        if (!report)
+            std::cerr << "Failed to read " << path << "\n";
+        return report;
+    }
+
+    void printEnvironment(const char* label, const Bench::Environment& environment)
+    {
+        std::cout << std::format("{:<9} {} {} ({}, {}, {} threads, {})\n", label, environment.commit, environment.timestamp,
+                                 environment.cpu, environment.compiler, environment.threads, environment.simd);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Arguments arguments;
+    if (!parseArguments(argc, argv, arguments))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const auto baseline { load(arguments.baselinePath) };
+    const auto current { load(arguments.currentPath) };
+    if (!baseline || !current)
+        return 1;
+
+    printEnvironment("baseline:", baseline->environment);
+    printEnvironment("current:", current->environment);
+    if (baseline->environment.cpu != current->environment.cpu)
+        std::cout << "warning: different CPUs, the changes say little about the code\n";
+    std::cout << "\n";
+
+    std::cout << std::format("{:<48} {:>8} {:>12} {:>12} {:>9} {:>9}  {}\n",
+                             "benchmark", "isa", "base ns/op", "ns/op", "change", "p", "verdict");
+
+    std::size_t slower { 0 }, faster { 0 };
+    for (const Bench::Comparison& comparison : Bench::compare(*baseline, *current, arguments.options))
+    {
+        slower += comparison.verdict == Bench::Verdict::Slower;
+        faster += comparison.verdict == Bench::Verdict::Faster;
+        if (arguments.changedOnly && comparison.verdict == Bench::Verdict::Unchanged)
+            continue;
+
+        std::cout << std::format("{:<48} {:>8} {:>12.2f} {:>12.2f} {:>+8.1f}% {:>9.2g}  {}\n",
+                                 comparison.name, comparison.isa, comparison.baselineNs, comparison.currentNs,
+                                 comparison.change * 100.0, comparison.pValue, Bench::toString(comparison.verdict));
+    }
+
+    std::cout << std::format("\n{} slower, {} faster (alpha {}, threshold {:.0f}%)\n",
+                             slower, faster, arguments.options.alpha, arguments.options.threshold * 100.0);
+    return slower > 0 ? 2 : 0;
+}
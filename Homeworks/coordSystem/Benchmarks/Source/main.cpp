@@ -0,0 +1,144 @@
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+#include "Benchmark/Benchmark.h"
+#include "Benchmark/CoordinateBenchmarks.h"
+#include "Benchmark/Report.h"
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/MathAccuracy.h"
+
+namespace
+{
+    struct Arguments
+    {
+        std::size_t size{ 1 << 20 };
+        std::uint32_t seed{ 42 };
+        // Only cases whose name contains this
+        std::string_view filter;
+        // Result files, not written if empty
+        std::string_view jsonPath;
+        std::string_view csvPath;
+        Bench::Options options;
+    };
+
+    void printUsage(const char* program)
+    {
+        std::cout << "Usage: " << program << " [--size N] [--repetitions N] [--warmup N] [--seed N] [--filter TEXT]"
+                     " [--json FILE] [--csv FILE]\n";
+    }
+
+    template <typename T>
+    bool parseNumber(const std::string_view text, T& value)
+    {
+        const auto [end, ec] { std::from_chars(text.data(), text.data() + text.size(), value) };
+        return ec == std::errc{} && end == text.data() + text.size();
+    }
+
+    bool parseArguments(const int argc, char** argv, Arguments& arguments)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view option { argv[i] };
+            if (i + 1 >= argc)
+                return false;
+
+            const std::string_view value { argv[++i] };
+            bool valid { true };
+            if (option == "--size")
+                valid = parseNumber(value, arguments.size);
+            else if (option == "--repetitions")
+                valid = parseNumber(value, arguments.options.repetitions);
+            else if (option == "--warmup")
+                valid = parseNumber(value, arguments.options.warmupRuns);
+            else if (option == "--seed")
+                valid = parseNumber(value, arguments.seed);
+            else if (option == "--filter")
+                arguments.filter = value;
+            else if (option == "--json")
+                arguments.jsonPath = value;
+            else if (option == "--csv")
+                arguments.csvPath = value;
+            else
+                valid = false;
+
+            if (!valid)
+                return false;
+        }
+        return arguments.options.repetitions > 0;
+    }
+
+    // Measures Math against libm and prints it, false if it exceeds the bounds MathPolicy.h documents
+    template <typename Math>
+    bool checkAccuracy(const char* name)
+    {
+        const Coord::PolicyAccuracy accuracy { Coord::measureAccuracy<Math>() };
+        const bool within { Coord::withinBounds(accuracy, Coord::documentedBounds<Math>()) };
+
+        std::cout << std::format("{:<16} {}\n", name, within ? "ok" : "EXCEEDS DOCUMENTED BOUNDS");
+
+        // The mean shows a drift the max can hide, e.g. float sin/cos that are bounded in absolute error only
+        const std::pair<const char*, const Coord::ErrorStats&> functions[] {
+            { "sin", accuracy.sin }, { "cos", accuracy.cos }, { "atan2", accuracy.atan2 },
+            { "acos", accuracy.acos }, { "Simd::sin", accuracy.simdSin }
+        };
+        for (const auto& [function, stats] : functions)
+        {
+            std::cout << std::format("  {:<10} max ULP {:<4.0f} mean ULP {:<8.3f} max abs {:<9.2g} mean abs {:.2g}\n",
+                                     function, stats.maxUlp, stats.meanUlp, stats.maxAbs, stats.meanAbs);
+        }
+        return within;
+    }
+
+    template <typename Write>
+    bool writeReport(const std::string_view path, const Bench::Report& report, Write write)
+    {
+        if (path.empty())
+            return true;
+
+        std::ofstream file { std::string(path) };
+        write(file, report);
+        if (!file)
+            std::cerr << "Failed to write " << path << "\n";
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Arguments arguments;
+    if (!parseArguments(argc, argv, arguments))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "points: " << arguments.size << ", repetitions: " << arguments.options.repetitions
+              << ", warmup: " << arguments.options.warmupRuns << ", SIMD: " << Coord::toString(Coord::detectSimdLevel()) << "\n";
+
+    Bench::Report report { Bench::currentEnvironment() };
+    std::cout << "cpu: " << report.environment.cpu << ", commit: " << report.environment.commit << "\n\n";
+
+    // A regressed polynomial fails the run even if every case is fast
+    const bool fastMathAccurate { checkAccuracy<Coord::FastMath>("FastMath") };
+    const bool fastFloat32Accurate { checkAccuracy<Coord::FastFloat32Math>("FastFloat32Math") };
+    std::cout << "\n";
+
+    Bench::printHeader(std::cout);
+    for (const Bench::Case& benchmark : Bench::makeCoordinateBenchmarks(arguments.size, arguments.seed))
+    {
+        if (!arguments.filter.empty() && benchmark.name.find(arguments.filter) == std::string::npos)
+            continue;
+
+        report.results.push_back(Bench::run(benchmark, arguments.options));
+        Bench::print(std::cout, report.results.back());
+    }
+
+    const bool jsonWritten { writeReport(arguments.jsonPath, report, Bench::writeJson) };
+    const bool csvWritten { writeReport(arguments.csvPath, report, Bench::writeCsv) };
+    return jsonWritten && csvWritten && fastMathAccurate && fastFloat32Accurate ? 0 : 1;
+}
@@ -0,0 +1,14 @@
+# Run by the GitCommit target on every build, with SOURCE_DIR, INPUT and OUTPUT set.
+# configure_file only writes OUTPUT when the commit changed, so nothing is rebuilt otherwise
+execute_process(
+        COMMAND git rev-parse --short HEAD
+        WORKING_DIRECTORY ${SOURCE_DIR}
+        OUTPUT_VARIABLE COORDSYSTEM_GIT_COMMIT
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        ERROR_QUIET
+)
+if (NOT COORDSYSTEM_GIT_COMMIT)
+    set(COORDSYSTEM_GIT_COMMIT unknown)
+endif()
+
+configure_file(${INPUT} ${OUTPUT} @ONLY)
@@ -0,0 +1,97 @@
+#include "BackgroundRunner.h"
+
+#include <cstddef>
+#include <exception>
+
+namespace Bench
+{
+    BackgroundRunner::~BackgroundRunner()
+    {
+        // Before the members the thread uses are destroyed
+        Cancel();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void BackgroundRunner::Start(CaseFactory makeCases, const Options& options, std::function<bool(const Case&)> filter)
+    {
+        // Joins the previous run
+        m_thread = {};
+
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_progress = Progress{};
+            m_progress.running = true;
+            m_results.clear();
+        }
+
+        m_thread = std::jthread([this, makeCases = std::move(makeCases), options, filter = std::move(filter)](const std::stop_token& stop)
+        {
+            Run(stop, makeCases, options, filter);
+        });
+    }
+
+    void BackgroundRunner::Cancel()
+    {
+        m_thread.request_stop();
+    }
+
+    BackgroundRunner::Progress BackgroundRunner::GetProgress() const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return m_progress;
+    }
+
+    void BackgroundRunner::CopyNewResults(std::vector<Result>& results) const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (results.size() < m_results.size())
+            results.insert(results.end(), m_results.begin() + static_cast<std::ptrdiff_t>(results.size()), m_results.end());
+    }
+
+    void BackgroundRunner::Run(const std::stop_token& stop, const CaseFactory& makeCases, Options options,
+                               const std::function<bool(const Case&)>& filter)
+    {
+        options.stop = stop;
+
+        try
+        {
+            std::vector<Case> cases { makeCases() };
+            if (filter)
+                std::erase_if(cases, [&filter](const Case& benchmark) { return !filter(benchmark); });
+
+            {
+                std::lock_guard<std::mutex> lock(m_mtx);
+                m_progress.total = cases.size();
+            }
+
+            for (const Case& benchmark : cases)
+            {
+                if (stop.stop_requested())
+                    break;
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mtx);
+                    m_progress.current = benchmark.name;
+                }
+
+                Result result { Bench::run(benchmark, options) };
+
+                std::lock_guard<std::mutex> lock(m_mtx);
+                if (result.repetitions > 0)
+                    m_results.push_back(std::move(result));
+                ++m_progress.completed;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_progress.error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_progress.current.clear();
+        m_progress.running = false;
+        m_progress.cancelled = stop.stop_requested();
+    }
+}
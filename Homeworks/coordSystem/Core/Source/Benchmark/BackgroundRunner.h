@@ -0,0 +1,73 @@
+#ifndef COORDSYSTEM_BACKGROUNDRUNNER_H
+#define COORDSYSTEM_BACKGROUNDRUNNER_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark/Benchmark.h"
+
+namespace Bench
+{
+    /**
+     * Runs benchmarks on a thread of its own, so a UI keeps drawing while they run. The cases are made on
+     * that thread too, since building their input is often the slow part. Progress and the results finished
+     * so far can be read at any time from another thread.
+     */
+    class BackgroundRunner
+    {
+    public:
+        using CaseFactory = std::function<std::vector<Case>()>;
+
+        struct Progress
+        {
+            // Cases finished and selected, total is 0 while the cases are made
+            std::size_t completed{ 0 };
+            std::size_t total{ 0 };
+            std::string current;
+            bool running{ false };
+            bool cancelled{ false };
+            // What the factory or a case threw, empty if nothing
+            std::string error;
+        };
+    public:
+        BackgroundRunner() = default;
+        // Cancels and waits for the current repetition to finish
+        ~BackgroundRunner();
+
+        BackgroundRunner(const BackgroundRunner&) = delete;
+        BackgroundRunner& operator=(const BackgroundRunner&) = delete;
+
+        /**
+         * Cancels a run in progress, waits for it and starts a new one. Previous results are dropped.
+         *
+         * @param filter Cases it returns false for are skipped, nullptr runs all of them
+         */
+        void Start(CaseFactory makeCases, const Options& options, std::function<bool(const Case&)> filter = nullptr);
+
+        /**
+         * Stops after the current repetition, that case is reported with the repetitions it got
+         */
+        void Cancel();
+
+        [[nodiscard]] Progress GetProgress() const;
+
+        /**
+         * Appends the results finished since results was last filled by this call
+         */
+        void CopyNewResults(std::vector<Result>& results) const;
+    private:
+        void Run(const std::stop_token& stop, const CaseFactory& makeCases, Options options, const std::function<bool(const Case&)>& filter);
+    private:
+        std::jthread m_thread;
+
+        mutable std::mutex m_mtx;
+        Progress m_progress;
+        std::vector<Result> m_results;
+    };
+}
+
+#endif //COORDSYSTEM_BACKGROUNDRUNNER_H
@@ -0,0 +1,69 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <ostream>
+
+namespace Bench
+{
+    Statistics summarize(std::vector<double> samplesNs)
+    {
+        Statistics stats;
+        if (samplesNs.empty())
+            return stats;
+
+        std::ranges::sort(samplesNs);
+        const std::size_t n { samplesNs.size() };
+
+        stats.minNs = samplesNs.front();
+        stats.medianNs = n % 2 ? samplesNs[n / 2] : (samplesNs[n / 2 - 1] + samplesNs[n / 2]) / 2.0;
+        stats.meanNs = std::accumulate(samplesNs.begin(), samplesNs.end(), 0.0) / static_cast<double>(n);
+
+        const std::size_t p99Rank { static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(n))) };
+        stats.p99Ns = samplesNs[std::max<std::size_t>(p99Rank, 1) - 1];
+
+        double squares { 0.0 };
+        for (const double sample : samplesNs)
+            squares += (sample - stats.meanNs) * (sample - stats.meanNs);
+        stats.stddevNs = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0;
+
+        return stats;
+    }
+
+    Result run(const Case& benchmark, const Options& options)
+    {
+        for (std::size_t i = 0; i < options.warmupRuns && !options.stop.stop_requested(); ++i)
+            benchmark.body();
+
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        for (std::size_t i = 0; i < options.repetitions && !options.stop.stop_requested(); ++i)
+        {
+            const auto start { std::chrono::steady_clock::now() };
+            benchmark.body();
+            clobberMemory();
+            const auto end { std::chrono::steady_clock::now() };
+
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+
+        std::ranges::sort(samples);
+        return { benchmark.name, benchmark.items, samples.size(), benchmark.isa, summarize(samples), std::move(samples) };
+    }
+
+    void printHeader(std::ostream& out)
+    {
+        out << std::format("{:<48} {:>12} {:>12} {:>12} {:>10} {:>12}\n",
+                           "benchmark", "median us", "p99 us", "stddev us", "ns/op", "Mpoints/s");
+    }
+
+    void print(std::ostream& out, const Result& result)
+    {
+        out << std::format("{:<48} {:>12.1f} {:>12.1f} {:>12.1f} {:>10.2f} {:>12.1f}\n",
+                           result.name, result.stats.medianNs / 1.0e3, result.stats.p99Ns / 1.0e3,
+                           result.stats.stddevNs / 1.0e3, result.nsPerItem(), result.itemsPerSecond() / 1.0e6);
+    }
+}
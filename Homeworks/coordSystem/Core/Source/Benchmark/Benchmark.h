@@ -0,0 +1,94 @@
+#ifndef COORDSYSTEM_BENCHMARK_H
+#define COORDSYSTEM_BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Micro-benchmark harness: warmup runs, repeated timed runs on a steady clock and a statistical summary.
+// Used by the Benchmarks executable and by LB1.
+namespace Bench
+{
+    // Makes the optimizer assume value is read, so the work producing it can't be removed
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const volatile char sink { *reinterpret_cast<const volatile char*>(&value) };
+        static_cast<void>(sink);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // Makes the optimizer assume all memory is read, so stores into result buffers are kept
+    inline void clobberMemory()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    struct Options
+    {
+        // Untimed runs first, to fault in pages and warm up caches and branch predictors
+        std::size_t warmupRuns{ 2 };
+        std::size_t repetitions{ 20 };
+        // Checked before every run, a stopped benchmark returns the repetitions done so far
+        std::stop_token stop;
+    };
+
+    // Over the repetitions, in nanoseconds per run. p99 is the nearest rank, so the maximum below 100 runs
+    struct Statistics
+    {
+        double minNs{ 0.0 };
+        double medianNs{ 0.0 };
+        double meanNs{ 0.0 };
+        double p99Ns{ 0.0 };
+        double stddevNs{ 0.0 };
+    };
+
+    [[nodiscard]] Statistics summarize(std::vector<double> samplesNs);
+
+    struct Case
+    {
+        std::string name;
+        // Points processed by one run of body
+        std::size_t items{ 1 };
+        std::function<void()> body;
+        // Instruction set the case runs the batch functions at, empty if it runs at the default level
+        std::string isa;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::size_t items{ 1 };
+        std::size_t repetitions{ 0 };
+        std::string isa;
+        Statistics stats;
+        // Every timed run in ascending order, kept so runs can be compared by more than their summary
+        std::vector<double> samplesNs;
+
+        [[nodiscard]] double nsPerItem() const { return stats.medianNs / static_cast<double>(items); }
+        [[nodiscard]] double itemsPerSecond() const { return static_cast<double>(items) * 1.0e9 / stats.medianNs; }
+    };
+
+    [[nodiscard]] Result run(const Case& benchmark, const Options& options = {});
+
+    // Fixed width table, one line per result
+    void printHeader(std::ostream& out);
+    void print(std::ostream& out, const Result& result);
+}
+
+#endif //COORDSYSTEM_BENCHMARK_H
@@ -0,0 +1,524 @@
+#include "CoordinateBenchmarks.h"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <random>
+
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/BatchDistances.h"
+#include "Coordinates/BatchTransforms.h"
+#include "Coordinates/Distance.h"
+#include "Coordinates/DistanceMatrix.h"
+#include "Coordinates/Generators.h"
+#include "Coordinates/MortonOrder.h"
+#include "Coordinates/ParallelConversions.h"
+#include "Coordinates/PointArrays.h"
+#include "Coordinates/PreparedSpherical.h"
+#include "Coordinates/QuantizedArrays.h"
+#include "Coordinates/SpatialIndex.h"
+
+namespace Bench
+{
+    namespace
+    {
+        struct Dataset
+        {
+            Coord::PolarArray<> polar1, polar2;
+            Coord::CartesianArray2D<> cartesian2D1, cartesian2D2;
+            Coord::SphericalArray<> spherical1, spherical2;
+            Coord::CartesianArray3D<> cartesian3D1, cartesian3D2;
+            Coord::PreparedSphericalArray<> prepared2;
+
+            // Conversion results, and one distance per pair
+            Coord::PolarArray<> polarOut;
+            Coord::CartesianArray2D<> cartesian2DOut;
+            Coord::SphericalArray<> sphericalOut;
+            Coord::CartesianArray3D<> cartesian3DOut;
+            std::vector<double> distances;
+
+            // Of the multithreaded cases
+            Coord::ParallelOptions parallel;
+        };
+
+        std::shared_ptr<Dataset> makeDataset(const std::size_t size, const std::uint32_t seed, const std::size_t maxThreads)
+        {
+            auto data { std::make_shared<Dataset>() };
+            data->parallel.maxThreads = maxThreads;
+
+            // Every set gets its own seed, otherwise the sets would share their columns
+            const std::uint64_t firstSeed { std::uint64_t{ seed } << 2 };
+            data->polar1.resize(size);
+            data->polar2.resize(size);
+            data->spherical1.resize(size);
+            data->spherical2.resize(size);
+            Coord::Generate::polar(data->polar1.view(), firstSeed, {}, 0, data->parallel);
+            Coord::Generate::polar(data->polar2.view(), firstSeed + 1, {}, 0, data->parallel);
+            Coord::Generate::spherical(data->spherical1.view(), firstSeed + 2, {}, 0, data->parallel);
+            Coord::Generate::spherical(data->spherical2.view(), firstSeed + 3, {}, 0, data->parallel);
+
+            data->cartesian2D1 = Coord::CartesianArray2D<>::fromPolar(data->polar1);
+            data->cartesian2D2 = Coord::CartesianArray2D<>::fromPolar(data->polar2);
+            data->cartesian3D1 = Coord::CartesianArray3D<>::fromSpherical(data->spherical1);
+            data->cartesian3D2 = Coord::CartesianArray3D<>::fromSpherical(data->spherical2);
+            data->prepared2 = Coord::PreparedSphericalArray<>::fromSpherical(data->spherical2);
+
+            data->polarOut.resize(size);
+            data->cartesian2DOut.resize(size);
+            data->sphericalOut.resize(size);
+            data->cartesian3DOut.resize(size);
+            data->distances.resize(size);
+            return data;
+        }
+
+        // Case that runs body(level), which hands level to the batch functions. The level the rest of
+        // the program uses stays as it is while the benchmarks run in the background
+        template <typename Body>
+        Case atSimdLevel(std::string name, const std::size_t items, const Coord::SimdLevel level, Body body)
+        {
+            return { std::move(name), items, [level, body] { body(level); }, Coord::toString(level) };
+        }
+
+        void addConversions(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            cases.push_back({ "convert/polarToCartesian/point", size, [data]
+            {
+                for (std::size_t i = 0; i < data->polar1.size(); ++i)
+                {
+                    const auto c { CartesianPoint2D<double>::fromPolar(data->polar1[i]) };
+                    data->cartesian2DOut.x()[i] = c.x;
+                    data->cartesian2DOut.y()[i] = c.y;
+                }
+            } });
+            cases.push_back({ "convert/cartesianToPolar/point", size, [data]
+            {
+                for (std::size_t i = 0; i < data->cartesian2D1.size(); ++i)
+                {
+                    const auto p { PolarPoint::fromCartesian(data->cartesian2D1[i]) };
+                    data->polarOut.radius()[i] = p.radius;
+                    data->polarOut.theta()[i] = p.theta;
+                }
+            } });
+            cases.push_back({ "convert/sphericalToCartesian/point", size, [data]
+            {
+                for (std::size_t i = 0; i < data->spherical1.size(); ++i)
+                {
+                    const auto c { CartesianPoint3D<double>::fromSpherical(data->spherical1[i]) };
+                    data->cartesian3DOut.x()[i] = c.x;
+                    data->cartesian3DOut.y()[i] = c.y;
+                    data->cartesian3DOut.z()[i] = c.z;
+                }
+            } });
+            cases.push_back({ "convert/cartesianToSpherical/point", size, [data]
+            {
+                for (std::size_t i = 0; i < data->cartesian3D1.size(); ++i)
+                {
+                    const auto s { SphericalPoint::fromCartesian(data->cartesian3D1[i]) };
+                    data->sphericalOut.radius()[i] = s.radius;
+                    data->sphericalOut.theta()[i] = s.theta;
+                    data->sphericalOut.polarAngle()[i] = s.polarAngle;
+                }
+            } });
+
+            const auto detected { static_cast<int>(Coord::detectSimdLevel()) };
+            for (int level = 0; level <= detected; ++level)
+            {
+                const auto simd { static_cast<Coord::SimdLevel>(level) };
+                const std::string suffix { std::format("batch-{}", Coord::toString(simd)) };
+
+                cases.push_back(atSimdLevel("convert/polarToCartesian/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::polarToCartesian(simdLevel, data->polar1.radius(), data->polar1.theta(),
+                                                   data->cartesian2DOut.x(), data->cartesian2DOut.y());
+                }));
+                cases.push_back(atSimdLevel("convert/cartesianToPolar/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::cartesianToPolar(simdLevel, data->cartesian2D1.x(), data->cartesian2D1.y(),
+                                                   data->polarOut.radius(), data->polarOut.theta());
+                }));
+                cases.push_back(atSimdLevel("convert/sphericalToCartesian/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::sphericalToCartesian(simdLevel, data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                       data->cartesian3DOut.x(), data->cartesian3DOut.y(), data->cartesian3DOut.z());
+                }));
+                cases.push_back(atSimdLevel("convert/cartesianToSpherical/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::cartesianToSpherical(simdLevel, data->cartesian3D1.x(), data->cartesian3D1.y(), data->cartesian3D1.z(),
+                                                       data->sphericalOut.radius(), data->sphericalOut.theta(), data->sphericalOut.polarAngle());
+                }));
+            }
+
+            cases.push_back({ "convert/polarToCartesian/parallel", size, [data]
+            {
+                Coord::Parallel::polarToCartesian(data->polar1.radius(), data->polar1.theta(),
+                                                  data->cartesian2DOut.x(), data->cartesian2DOut.y(), data->parallel);
+            } });
+            cases.push_back({ "convert/cartesianToPolar/parallel", size, [data]
+            {
+                Coord::Parallel::cartesianToPolar(data->cartesian2D1.x(), data->cartesian2D1.y(),
+                                                  data->polarOut.radius(), data->polarOut.theta(), data->parallel);
+            } });
+            cases.push_back({ "convert/sphericalToCartesian/parallel", size, [data]
+            {
+                Coord::Parallel::sphericalToCartesian(data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                      data->cartesian3DOut.x(), data->cartesian3DOut.y(), data->cartesian3DOut.z(),
+                                                      data->parallel);
+            } });
+            cases.push_back({ "convert/cartesianToSpherical/parallel", size, [data]
+            {
+                Coord::Parallel::cartesianToSpherical(data->cartesian3D1.x(), data->cartesian3D1.y(), data->cartesian3D1.z(),
+                                                      data->sphericalOut.radius(), data->sphericalOut.theta(), data->sphericalOut.polarAngle(),
+                                                      data->parallel);
+            } });
+        }
+
+        // The spherical points stored in a smaller encoding, decoded block by block into double columns
+        // that stay in L1 and converted from there. The variant names the bytes per point, 24 as doubles
+        template <typename Codec>
+        Case quantizedSphericalToCartesian(const std::shared_ptr<Dataset>& data, const std::size_t size,
+                                           const char* encoding, const Codec& radius)
+        {
+            auto points { std::make_shared<Coord::QuantizedSphericalArray<Codec>>(
+                Coord::QuantizedSphericalArray<Codec>::fromArray(data->spherical1, radius)) };
+            const std::size_t bytesPerPoint { size > 0 ? points->memoryUsage() / size : 0 };
+
+            static constexpr std::size_t kBlock { 512 };
+            auto block { std::make_shared<Coord::SphericalArray<>>(kBlock) };
+            return { std::format("convert/sphericalToCartesian/{}-{}B", encoding, bytesPerPoint), size, [data, points, block]
+            {
+                const Coord::SphericalSpan<double> in { block->view() };
+                const Coord::Cartesian3DSpan<double> out { data->cartesian3DOut.view() };
+                for (std::size_t offset = 0; offset < points->size(); offset += kBlock)
+                {
+                    const std::size_t count { std::min(kBlock, points->size() - offset) };
+                    const Coord::SphericalSpan<double> decoded { in.radius.first(count), in.theta.first(count), in.polarAngle.first(count) };
+                    points->load(offset, decoded);
+                    Coord::Batch::sphericalToCartesian(decoded.radius, decoded.theta, decoded.polarAngle,
+                                                       out.x.subspan(offset, count), out.y.subspan(offset, count), out.z.subspan(offset, count));
+                }
+            } };
+        }
+
+        void addQuantizedConversions(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            // Radii of the generated points are in [0, 100]
+            cases.push_back(quantizedSphericalToCartesian(data, size, "float32", Coord::Float32Codec{}));
+            cases.push_back(quantizedSphericalToCartesian(data, size, "fixed16", Coord::FixedPoint16Codec::forRange(100.0)));
+        }
+
+        // A sensor mounted on a vehicle, both poses composed into one sensor to world transform
+        void addTransforms(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            const Coord::Affine2D<> mount2D { Coord::Affine2D<>::rigid(0.3, { 1.5, -0.2 }) };
+            const Coord::Affine2D<> vehicle2D { Coord::Affine2D<>::rigid(-1.1, { 250.0, 40.0 }) };
+            const Coord::Affine2D<> toWorld2D { mount2D.then(vehicle2D) };
+
+            const auto mount { Coord::Affine3D<>::rigid(Coord::Quaternion<>::fromYawPitchRoll(0.3, -0.05, 0.01), { 1.5, -0.2, 2.0 }) };
+            const auto vehicle { Coord::Affine3D<>::rigid(Coord::Quaternion<>::fromAxisAngle({ 0, 0, 1 }, -1.1), { 250.0, 40.0, 0.0 }) };
+            const Coord::Affine3D<> toWorld { mount.then(vehicle) };
+
+            cases.push_back({ "transform/affine3D/point", size, [data, toWorld]
+            {
+                for (std::size_t i = 0; i < data->cartesian3D1.size(); ++i)
+                {
+                    const CartesianPoint3D<double> c { toWorld(data->cartesian3D1[i]) };
+                    data->cartesian3DOut.x()[i] = c.x;
+                    data->cartesian3DOut.y()[i] = c.y;
+                    data->cartesian3DOut.z()[i] = c.z;
+                }
+            } });
+            // What the fused sphericalToWorld kernel saves: a second pass over the Cartesian columns
+            cases.push_back({ "transform/sphericalToWorld/convert-then-affine", size, [data, toWorld]
+            {
+                const Coord::Cartesian3DSpan<double> out { data->cartesian3DOut.view() };
+                Coord::sphericalToCartesian<double>(data->spherical1.view(), out);
+                Coord::Batch::transform(toWorld, out, out);
+            } });
+
+            const auto detected { static_cast<int>(Coord::detectSimdLevel()) };
+            for (int level = 0; level <= detected; ++level)
+            {
+                const auto simd { static_cast<Coord::SimdLevel>(level) };
+                const std::string suffix { std::format("batch-{}", Coord::toString(simd)) };
+
+                cases.push_back(atSimdLevel("transform/affine2D/" + suffix, size, simd, [data, toWorld2D](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::transform(simdLevel, toWorld2D, data->cartesian2D1.view(), data->cartesian2DOut.view());
+                }));
+                cases.push_back(atSimdLevel("transform/affine3D/" + suffix, size, simd, [data, toWorld](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::transform(simdLevel, toWorld, data->cartesian3D1.view(), data->cartesian3DOut.view());
+                }));
+                cases.push_back(atSimdLevel("transform/polarToWorld/" + suffix, size, simd, [data, toWorld2D](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::transform(simdLevel, toWorld2D, data->polar1.view(), data->cartesian2DOut.view());
+                }));
+                cases.push_back(atSimdLevel("transform/sphericalToWorld/" + suffix, size, simd, [data, toWorld](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::transform(simdLevel, toWorld, data->spherical1.view(), data->cartesian3DOut.view());
+                }));
+            }
+        }
+
+        // Morton ordering, and what it buys a neighbour search that visits the points in array order
+        void addReorders(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            cases.push_back({ "reorder/morton2D/order", size, [data]
+            {
+                doNotOptimize(Coord::Morton::order<double>(data->cartesian2D1.view()));
+            } });
+            cases.push_back({ "reorder/morton3D/order", size, [data]
+            {
+                doNotOptimize(Coord::Morton::order<double>(data->cartesian3D1.view()));
+            } });
+
+            using Point = CartesianPoint3D<double>;
+            auto arrival { std::make_shared<std::vector<Point>>(size) };
+            for (std::size_t i = 0; i < size; ++i)
+                (*arrival)[i] = data->cartesian3D1[i];
+            auto sorted { std::make_shared<std::vector<Point>>(*arrival) };
+            Coord::Morton::sort(*sorted);
+
+            // Same tree for both, only the order of the queries differs
+            auto tree { std::make_shared<Coord::KdTree<Point>>(*arrival) };
+            const auto nearestOfEvery = [tree](const std::shared_ptr<std::vector<Point>>& points)
+            {
+                return [tree, points]
+                {
+                    std::vector<Coord::Neighbor<double>> neighbors;
+                    for (const Point& p : *points)
+                    {
+                        tree->nearest(p, 8, neighbors);
+                        doNotOptimize(neighbors);
+                    }
+                };
+            };
+            cases.push_back({ "reorder/kdTreeNearest8/arrival-order", size, nearestOfEvery(arrival) });
+            cases.push_back({ "reorder/kdTreeNearest8/morton-order", size, nearestOfEvery(sorted) });
+        }
+
+        // One distance per pair of points at the same index
+        template <typename Math>
+        void addPairDistances(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size, const char* math)
+        {
+            cases.push_back({ std::format("distance/cartesian2D/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance2DCartesian<Math>(data->cartesian2D1[i], data->cartesian2D2[i]);
+            } });
+            cases.push_back({ std::format("distance/polar2D/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance2DPolar<Math>(data->polar1[i], data->polar2[i]);
+            } });
+            cases.push_back({ std::format("distance/cartesian3D/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance3DCartesian<Math>(data->cartesian3D1[i], data->cartesian3D2[i]);
+            } });
+            cases.push_back({ std::format("distance/chord/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance3DChord<Math>(data->spherical1[i], data->spherical2[i]);
+            } });
+            cases.push_back({ std::format("distance/arc/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance3DArc<Math>(data->spherical1[i], data->spherical2[i]);
+            } });
+            cases.push_back({ std::format("distance/vincenty/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance3DGreatCircle<Math>(data->spherical1[i], data->spherical2[i]);
+            } });
+            cases.push_back({ std::format("distance/haversine/{}", math), size, [data]
+            {
+                for (std::size_t i = 0; i < data->distances.size(); ++i)
+                    data->distances[i] = Coord::distance3DHaversine<Math>(data->spherical1[i], data->spherical2[i]);
+            } });
+        }
+
+        // The same pairs through the batch kernels, plus one-to-many from the first point of the first set
+        void addBatchDistances(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            const auto detected { static_cast<int>(Coord::detectSimdLevel()) };
+            for (int level = 0; level <= detected; ++level)
+            {
+                const auto simd { static_cast<Coord::SimdLevel>(level) };
+                const std::string suffix { std::format("batch-{}", Coord::toString(simd)) };
+
+                cases.push_back(atSimdLevel("distance/cartesian2D/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance2DCartesian(simdLevel, data->cartesian2D1.x(), data->cartesian2D1.y(),
+                                                      data->cartesian2D2.x(), data->cartesian2D2.y(), data->distances);
+                }));
+                cases.push_back(atSimdLevel("distance/polar2D/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance2DPolar(simdLevel, data->polar1.radius(), data->polar1.theta(),
+                                                  data->polar2.radius(), data->polar2.theta(), data->distances);
+                }));
+                cases.push_back(atSimdLevel("distance/cartesian3D/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance3DCartesian(simdLevel, data->cartesian3D1.x(), data->cartesian3D1.y(), data->cartesian3D1.z(),
+                                                      data->cartesian3D2.x(), data->cartesian3D2.y(), data->cartesian3D2.z(),
+                                                      data->distances);
+                }));
+                cases.push_back(atSimdLevel("distance/chord/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance3DChord(simdLevel, data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                  data->spherical2.radius(), data->spherical2.theta(), data->spherical2.polarAngle(),
+                                                  data->distances);
+                }));
+                cases.push_back(atSimdLevel("distance/arc/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance3DArc(simdLevel, data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                data->spherical2.radius(), data->spherical2.theta(), data->spherical2.polarAngle(),
+                                                data->distances);
+                }));
+                cases.push_back(atSimdLevel("distance/vincenty/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance3DGreatCircle(simdLevel, data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                        data->spherical2.radius(), data->spherical2.theta(), data->spherical2.polarAngle(),
+                                                        data->distances, Coord::Batch::GreatCircleFormula::Vincenty);
+                }));
+                cases.push_back(atSimdLevel("distance/haversine/" + suffix, size, simd, [data](const Coord::SimdLevel simdLevel)
+                {
+                    Coord::Batch::distance3DGreatCircle(simdLevel, data->spherical1.radius(), data->spherical1.theta(), data->spherical1.polarAngle(),
+                                                        data->spherical2.radius(), data->spherical2.theta(), data->spherical2.polarAngle(),
+                                                        data->distances, Coord::Batch::GreatCircleFormula::Haversine);
+                }));
+            }
+
+            if (size == 0)
+                return;
+
+            const SphericalPoint from { data->spherical1[0] };
+            cases.push_back({ "distance/chord/batch-one-to-many", size, [data, from]
+            {
+                Coord::Batch::distance3DChord(from, data->spherical2.radius(), data->spherical2.theta(),
+                                              data->spherical2.polarAngle(), data->distances);
+            } });
+            cases.push_back({ "distance/arc/batch-one-to-many", size, [data, from]
+            {
+                Coord::Batch::distance3DArc(from, data->spherical2.radius(), data->spherical2.theta(),
+                                            data->spherical2.polarAngle(), data->distances);
+            } });
+            cases.push_back({ "distance/vincenty/batch-one-to-many", size, [data, from]
+            {
+                Coord::Batch::distance3DGreatCircle(from, data->spherical2.radius(), data->spherical2.theta(),
+                                                    data->spherical2.polarAngle(), data->distances,
+                                                    Coord::Batch::GreatCircleFormula::Vincenty);
+            } });
+            cases.push_back({ "distance/haversine/batch-one-to-many", size, [data, from]
+            {
+                Coord::Batch::distance3DGreatCircle(from, data->spherical2.radius(), data->spherical2.theta(),
+                                                    data->spherical2.polarAngle(), data->distances,
+                                                    Coord::Batch::GreatCircleFormula::Haversine);
+            } });
+        }
+
+        void addPreparedDistances(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            if (size == 0)
+                return;
+
+            const auto from { Coord::PreparedSphericalPoint<>::fromSpherical(data->spherical1[0]) };
+            cases.push_back({ "distance/chord/prepared-one-to-many", size, [data, from]
+            {
+                Coord::distance3DChord(from, data->prepared2, data->distances);
+            } });
+            cases.push_back({ "distance/arc/prepared-one-to-many", size, [data, from]
+            {
+                Coord::distance3DArc(from, data->prepared2, data->distances);
+            } });
+            cases.push_back({ "distance/greatCircle/prepared-one-to-many", size, [data, from]
+            {
+                Coord::greatCircleDistance(from, data->prepared2, 1.0, data->distances);
+            } });
+        }
+
+        // Random spherical points: one std::mt19937 as the labs used to, and the counter-based generator
+        void addGenerators(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data, const std::size_t size)
+        {
+            cases.push_back({ "generate/spherical/mt19937", size, [data]
+            {
+                std::mt19937 mt{ 42 };
+                std::uniform_real_distribution<double> radius{ 0.0, 100.0 };
+                std::uniform_real_distribution<double> azimuth{ -Coord::Simd::kPi, Coord::Simd::kPi };
+                std::uniform_real_distribution<double> polarAngle{ 0.0, Coord::Simd::kPi };
+                for (std::size_t i = 0; i < data->sphericalOut.size(); ++i)
+                {
+                    data->sphericalOut.radius()[i] = radius(mt);
+                    data->sphericalOut.theta()[i] = azimuth(mt);
+                    data->sphericalOut.polarAngle()[i] = polarAngle(mt);
+                }
+            } });
+            cases.push_back({ "generate/spherical/philox", size, [data]
+            {
+                Coord::Generate::spherical(data->sphericalOut.view(), 42, {}, 0, { .maxThreads = 1 });
+            } });
+            cases.push_back({ "generate/spherical/philox-parallel", size, [data]
+            {
+                Coord::Generate::spherical(data->sphericalOut.view(), 42, {}, 0, data->parallel);
+            } });
+        }
+
+        // Distances within the first points of the first set, items are matrix entries
+        void addDistanceMatrices(std::vector<Case>& cases, const std::shared_ptr<Dataset>& data)
+        {
+            constexpr std::size_t kMaxMatrixPoints { 2048 };
+            const std::size_t points { std::min(data->cartesian3D1.size(), kMaxMatrixPoints) };
+            if (points < 2)
+                return;
+
+            auto cartesian { std::make_shared<Coord::CartesianArray3D<>>() };
+            auto spherical { std::make_shared<Coord::SphericalArray<>>() };
+            for (std::size_t i = 0; i < points; ++i)
+            {
+                cartesian->push_back(data->cartesian3D1[i]);
+                spherical->push_back(data->spherical1[i]);
+            }
+
+            Coord::MatrixOptions full;
+            full.maxThreads = data->parallel.maxThreads;
+            Coord::MatrixOptions triangular { full };
+            triangular.layout = Coord::MatrixLayout::UpperTriangular;
+            const std::size_t pairs { Coord::matrixEntryCount(points, points, triangular.layout) };
+
+            cases.push_back({ "matrix/cartesian3D/full", points * points, [cartesian, full]
+            {
+                doNotOptimize(Coord::Matrix::distance3DCartesian(*cartesian, *cartesian, full));
+            } });
+            cases.push_back({ "matrix/cartesian3D/upper-float", pairs, [cartesian, triangular]
+            {
+                doNotOptimize(Coord::Matrix::distance3DCartesian<float>(*cartesian, *cartesian, triangular));
+            } });
+            cases.push_back({ "matrix/chord/upper-float", pairs, [spherical, triangular]
+            {
+                doNotOptimize(Coord::Matrix::distance3DSpherical<float>(*spherical, *spherical, Coord::SphericalMetric::Chord, triangular));
+            } });
+            cases.push_back({ "matrix/arc/upper-float", pairs, [spherical, triangular]
+            {
+                doNotOptimize(Coord::Matrix::distance3DSpherical<float>(*spherical, *spherical, Coord::SphericalMetric::Arc, triangular));
+            } });
+        }
+    }
+
+    std::vector<Case> makeCoordinateBenchmarks(const std::size_t size, const std::uint32_t seed, const std::size_t maxThreads)
+    {
+        const std::shared_ptr<Dataset> data { makeDataset(size, seed, maxThreads) };
+
+        std::vector<Case> cases;
+        addConversions(cases, data, size);
+        addQuantizedConversions(cases, data, size);
+        addTransforms(cases, data, size);
+        addReorders(cases, data, size);
+        addGenerators(cases, data, size);
+        addPairDistances<Coord::ExactMath>(cases, data, size, "exact");
+        addPairDistances<Coord::FastMath>(cases, data, size, "fast");
+        addBatchDistances(cases, data, size);
+        addPreparedDistances(cases, data, size);
+        addDistanceMatrices(cases, data);
+        return cases;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef COORDSYSTEM_COORDINATEBENCHMARKS_H
+#define COORDSYSTEM_COORDINATEBENCHMARKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Benchmark/Benchmark.h"
+
+namespace Bench
+{
+    /**
+     * Cases for every conversion and distance function over size random points, named "group/function/variant":
+     *   convert/...   point by point, the batch kernel at every supported SIMD level, multithreaded, and
+     *                 decoded from quantized storage with the bytes per point in the variant
+     *   transform/... sensor to world transforms point by point and at every SIMD level, and converting then transforming
+     *                 against the fused polar/spherical kernels
+     *   reorder/...   Morton ordering, and k-nearest queries on a k-d tree visited in arrival and in Morton order
+     *   generate/...  random points with std::mt19937 and with the counter-based generators
+     *   distance/...  per pair with ExactMath and FastMath, and one-to-many over prepared points
+     *   matrix/...    all-pairs distances of the first 2048 points, full and upper triangular, items are matrix entries
+     * The cases share their input and output buffers, so run them one at a time.
+     *
+     * @param maxThreads Threads of the multithreaded cases, 0 uses every thread of Core::ThreadPool::Get()
+     */
+    [[nodiscard]] std::vector<Case> makeCoordinateBenchmarks(std::size_t size, std::uint32_t seed = 42, std::size_t maxThreads = 0);
+}
+
+#endif //COORDSYSTEM_COORDINATEBENCHMARKS_H
@@ -0,0 +1,310 @@
+#include "Report.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "Coordinates/BatchConversions.h"
+#include "GitCommit.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace Bench
+{
+    namespace
+    {
+        // Brand string from the extended CPUID leaves, e.g. "AMD Ryzen 9 7950X 16-Core Processor"
+        std::string cpuModel()
+        {
+            unsigned int words[12] {};
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int info[4];
+            __cpuid(info, static_cast<int>(0x80000000));
+            if (static_cast<unsigned int>(info[0]) < 0x80000004)
+                return "unknown";
+            for (unsigned int leaf = 0; leaf < 3; ++leaf)
+            {
+                __cpuid(info, static_cast<int>(0x80000002 + leaf));
+                std::copy(info, info + 4, reinterpret_cast<int*>(words) + leaf * 4);
+            }
+#elif defined(__x86_64__) || defined(__i386__)
+            if (__get_cpuid_max(0x80000000, nullptr) < 0x80000004)
+                return "unknown";
+            for (unsigned int leaf = 0; leaf < 3; ++leaf)
+                __get_cpuid(0x80000002 + leaf, &words[leaf * 4], &words[leaf * 4 + 1], &words[leaf * 4 + 2], &words[leaf * 4 + 3]);
+#else
+            return "unknown";
+#endif
+            std::string model(reinterpret_cast<const char*>(words), sizeof(words));
+            model.erase(std::ranges::find(model, '\0'), model.end());
+
+            const auto first { model.find_first_not_of(' ') };
+            const auto last { model.find_last_not_of(' ') };
+            return first == std::string::npos ? "unknown" : model.substr(first, last - first + 1);
+        }
+
+        std::string compilerName()
+        {
+#if defined(__clang__)
+            return std::format("clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+            return std::format("gcc {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+            return std::format("msvc {}", _MSC_FULL_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        // Quoted only when it has to be, names of the cases never are
+        std::string csvField(const std::string& value)
+        {
+            if (value.find_first_of(",\"\n") == std::string::npos)
+                return value;
+
+            std::string quoted { "\"" };
+            for (const char c : value)
+            {
+                if (c == '"')
+                    quoted += '"';
+                quoted += c;
+            }
+            return quoted + '"';
+        }
+
+        // The samples of one run per item, so reports of different sizes can be compared
+        std::vector<double> samplesPerItem(const Result& result)
+        {
+            std::vector<double> samples(result.samplesNs);
+            for (double& sample : samples)
+                sample /= static_cast<double>(result.items);
+            return samples;
+        }
+    }
+
+    Environment currentEnvironment()
+    {
+        const auto now { std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()) };
+        return {
+            .cpu = cpuModel(),
+            .commit = COORDSYSTEM_GIT_COMMIT,
+            .compiler = compilerName(),
+            .simd = Coord::toString(Coord::detectSimdLevel()),
+            .threads = std::thread::hardware_concurrency(),
+            .timestamp = std::format("{:%FT%TZ}", now)
+        };
+    }
+
+    void writeJson(std::ostream& out, const Report& report)
+    {
+        const Environment& environment { report.environment };
+        json document = {
+            { "environment", {
+                { "cpu", environment.cpu },
+                { "commit", environment.commit },
+                { "compiler", environment.compiler },
+                { "simd", environment.simd },
+                { "threads", environment.threads },
+                { "timestamp", environment.timestamp }
+            } },
+            { "results", json::array() }
+        };
+
+        for (const Result& result : report.results)
+        {
+            document["results"].push_back({
+                { "name", result.name },
+                { "isa", result.isa.empty() ? environment.simd : result.isa },
+                { "items", result.items },
+                { "repetitions", result.repetitions },
+                { "minNs", result.stats.minNs },
+                { "medianNs", result.stats.medianNs },
+                { "meanNs", result.stats.meanNs },
+                { "p99Ns", result.stats.p99Ns },
+                { "stddevNs", result.stats.stddevNs },
+                { "nsPerItem", result.nsPerItem() },
+                { "itemsPerSecond", result.itemsPerSecond() },
+                { "samplesNs", result.samplesNs }
+            });
+        }
+
+        out << document.dump(2) << '\n';
+    }
+
+    void writeCsv(std::ostream& out, const Report& report)
+    {
+        const Environment& environment { report.environment };
+        out << "name,isa,items,repetitions,median_ns,p99_ns,stddev_ns,ns_per_item,items_per_second,"
+               "cpu,commit,compiler,threads,timestamp\n";
+
+        for (const Result& result : report.results)
+        {
+            out << std::format("{},{},{},{},{:.1f},{:.1f},{:.1f},{:.4f},{:.1f},{},{},{},{},{}\n",
+                               csvField(result.name), result.isa.empty() ? environment.simd : result.isa,
+                               result.items, result.repetitions, result.stats.medianNs, result.stats.p99Ns,
+                               result.stats.stddevNs, result.nsPerItem(), result.itemsPerSecond(),
+                               csvField(environment.cpu), csvField(environment.commit), csvField(environment.compiler),
+                               environment.threads, environment.timestamp);
+        }
+    }
+
+    std::optional<Report> readJson(std::istream& in)
+    {
+        // Not braces, those would make an array holding the document
+        const json document = json::parse(in, nullptr, false);
+        if (document.is_discarded() || !document.contains("environment") || !document.contains("results"))
+            return std::nullopt;
+
+        try
+        {
+            Report report;
+            const json& environment = document["environment"];
+            report.environment = {
+                .cpu = environment.value("cpu", ""),
+                .commit = environment.value("commit", ""),
+                .compiler = environment.value("compiler", ""),
+                .simd = environment.value("simd", ""),
+                .threads = environment.value("threads", std::size_t{ 0 }),
+                .timestamp = environment.value("timestamp", "")
+            };
+
+            for (const json& entry : document["results"])
+            {
+                Result result;
+                result.name = entry.at("name").get<std::string>();
+                result.isa = entry.value("isa", "");
+                result.items = std::max(entry.at("items").get<std::size_t>(), std::size_t{ 1 });
+                result.samplesNs = entry.value("samplesNs", std::vector<double>{});
+                std::ranges::sort(result.samplesNs);
+                result.repetitions = result.samplesNs.size();
+                result.stats = summarize(result.samplesNs);
+
+                // Results without samples still show their median and change, but with nothing to test
+                // compare() always reports them unchanged
+                if (result.samplesNs.empty())
+                    result.stats.medianNs = entry.at("medianNs").get<double>();
+
+                report.results.push_back(std::move(result));
+            }
+            return report;
+        }
+        catch (const json::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    const char* toString(const Verdict verdict)
+    {
+        switch (verdict)
+        {
+            case Verdict::Unchanged: return "unchanged";
+            case Verdict::Faster:    return "faster";
+            case Verdict::Slower:    return "SLOWER";
+            case Verdict::Missing:   return "missing";
+            case Verdict::Added:     return "added";
+        }
+        return "unknown";
+    }
+
+    double mannWhitneyPValue(const std::span<const double> a, const std::span<const double> b)
+    {
+        const std::size_t n1 { a.size() }, n2 { b.size() };
+        if (n1 == 0 || n2 == 0)
+            return 1.0;
+
+        // Pool both samples, remembering where each value came from
+        std::vector<std::pair<double, bool>> pooled;
+        pooled.reserve(n1 + n2);
+        for (const double value : a)
+            pooled.emplace_back(value, true);
+        for (const double value : b)
+            pooled.emplace_back(value, false);
+        std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+        // Ties get the average of their ranks
+        const double n { static_cast<double>(n1 + n2) };
+        double rankSumA { 0.0 }, tieTerm { 0.0 };
+        for (std::size_t first = 0; first < pooled.size();)
+        {
+            std::size_t last { first + 1 };
+            while (last < pooled.size() && pooled[last].first == pooled[first].first)
+                ++last;
+
+            const double ties { static_cast<double>(last - first) };
+            const double rank { (static_cast<double>(first + 1) + static_cast<double>(last)) / 2.0 };
+            for (std::size_t i = first; i < last; ++i)
+                if (pooled[i].second)
+                    rankSumA += rank;
+
+            tieTerm += ties * ties * ties - ties;
+            first = last;
+        }
+
+        const double u { rankSumA - static_cast<double>(n1) * static_cast<double>(n1 + 1) / 2.0 };
+        const double mean { static_cast<double>(n1) * static_cast<double>(n2) / 2.0 };
+        const double variance { static_cast<double>(n1) * static_cast<double>(n2) / 12.0 * (n + 1.0 - tieTerm / (n * (n - 1.0))) };
+        if (variance <= 0.0)
+            return 1.0;
+
+        // With continuity correction
+        const double z { std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance) };
+        return std::erfc(z / std::sqrt(2.0));
+    }
+
+    std::vector<Comparison> compare(const Report& baseline, const Report& current, const CompareOptions& options)
+    {
+        const auto key = [](const Result& result) { return result.name + '@' + result.isa; };
+
+        std::map<std::string, const Result*> baselineResults;
+        for (const Result& result : baseline.results)
+            baselineResults.emplace(key(result), &result);
+
+        std::vector<Comparison> comparisons;
+        for (const Result& result : current.results)
+        {
+            Comparison comparison { .name = result.name, .isa = result.isa, .currentNs = result.nsPerItem() };
+
+            const auto found { baselineResults.find(key(result)) };
+            if (found == baselineResults.end())
+            {
+                comparison.verdict = Verdict::Added;
+                comparisons.push_back(std::move(comparison));
+                continue;
+            }
+
+            const Result& before { *found->second };
+            baselineResults.erase(found);
+
+            comparison.baselineNs = before.nsPerItem();
+            comparison.change = comparison.currentNs / comparison.baselineNs - 1.0;
+            comparison.pValue = mannWhitneyPValue(samplesPerItem(before), samplesPerItem(result));
+
+            if (comparison.pValue < options.alpha && std::abs(comparison.change) > options.threshold)
+                comparison.verdict = comparison.change > 0.0 ? Verdict::Slower : Verdict::Faster;
+            comparisons.push_back(std::move(comparison));
+        }
+
+        // Whatever is left only ran in the baseline, in its original order
+        for (const Result& result : baseline.results)
+        {
+            if (baselineResults.contains(key(result)))
+                comparisons.push_back({ .name = result.name, .isa = result.isa, .baselineNs = result.nsPerItem(), .verdict = Verdict::Missing });
+        }
+
+        return comparisons;
+    }
+}
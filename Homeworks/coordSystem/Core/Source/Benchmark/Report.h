@@ -0,0 +1,99 @@
+#ifndef COORDSYSTEM_REPORT_H
+#define COORDSYSTEM_REPORT_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Benchmark/Benchmark.h"
+
+// Machine-readable benchmark results, so runs can be tracked across builds and machines,
+// and the comparison of two of them.
+namespace Bench
+{
+    // Where the results were measured
+    struct Environment
+    {
+        std::string cpu;
+        // Commit the build was configured at, "unknown" outside of a git checkout
+        std::string commit;
+        std::string compiler;
+        // Highest instruction set the batch functions can use on this machine
+        std::string simd;
+        std::size_t threads{ 0 };
+        // UTC, ISO 8601
+        std::string timestamp;
+    };
+
+    [[nodiscard]] Environment currentEnvironment();
+
+    struct Report
+    {
+        Environment environment;
+        std::vector<Result> results;
+    };
+
+    /**
+     * One object with the environment and every result including its samples, readable with readJson
+     */
+    void writeJson(std::ostream& out, const Report& report);
+
+    /**
+     * Header plus one row per result with the environment repeated in every row, without the samples
+     */
+    void writeCsv(std::ostream& out, const Report& report);
+
+    /**
+     * @return The report written by writeJson, nullopt if the input isn't one
+     */
+    [[nodiscard]] std::optional<Report> readJson(std::istream& in);
+
+    enum class Verdict
+    {
+        Unchanged,
+        Faster,
+        Slower,
+        // In only one of the reports
+        Missing,
+        Added
+    };
+
+    [[nodiscard]] const char* toString(Verdict verdict);
+
+    struct CompareOptions
+    {
+        // Significance level of the Mann-Whitney U test on the samples
+        double alpha{ 0.01 };
+        // Smallest relative change of the median that counts, below it the difference is noise we don't care about
+        double threshold{ 0.05 };
+    };
+
+    struct Comparison
+    {
+        std::string name;
+        std::string isa;
+        double baselineNs{ 0.0 };
+        double currentNs{ 0.0 };
+        // current / baseline - 1 of the medians per item
+        double change{ 0.0 };
+        double pValue{ 1.0 };
+        Verdict verdict{ Verdict::Unchanged };
+    };
+
+    /**
+     * Two-sided p-value of the Mann-Whitney U test, normal approximation with tie correction.
+     * Timing samples are skewed and have outliers, so ranks are safer than a t-test on the means.
+     */
+    [[nodiscard]] double mannWhitneyPValue(std::span<const double> a, std::span<const double> b);
+
+    /**
+     * Matches the results by name and ISA. A change is Slower or Faster only if it is both
+     * significant and larger than the threshold, so results without samples are always Unchanged.
+     */
+    [[nodiscard]] std::vector<Comparison> compare(const Report& baseline, const Report& current, const CompareOptions& options = {});
+}
+
+#endif //COORDSYSTEM_REPORT_H
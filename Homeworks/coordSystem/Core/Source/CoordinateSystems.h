@@ -2,57 +2,84 @@
 #define LB2_COORDINATESYSTEMS_H
 
 #include <cmath>
+#include <format>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include "Coordinates/MathPolicy.h"
 
 
 
 template <typename T>
 class CartesianPoint2D;
 
-class PolarPoint
+// All point types take the precision of their coordinates as T.
+// PolarPoint, SphericalPoint and CylindricalPoint are the double versions.
+//
+// Points are plain aggregates: PolarPoint p{ radius, theta }. They can be assigned, sorted,
+// memcpy'd and used in constant expressions.
+template <typename T>
+class BasicPolarPoint
 {
 public:
-    PolarPoint(double radius, double angle)
-        : m_radius{ radius }, m_theta{ angle }
-    {}
-
-    template <typename T>
-    static PolarPoint fromCartesian(const CartesianPoint2D<T>& p)
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr BasicPolarPoint fromCartesian(const CartesianPoint2D<U>& p)
     {
-        const double radius { std::sqrt(std::pow(p.getX(), 2) + std::pow(p.getY(), 2)) };
-        const double theta { std::atan2(p.getY(), p.getX()) };
+        using Real = typename Math::Real;
+        const Real x { static_cast<Real>(p.getX()) };
+        const Real y { static_cast<Real>(p.getY()) };
+
+        const T radius = Math::sqrt(x * x + y * y);
+        const T theta = Math::atan2(y, x);
         return { radius, theta };
     }
 
-    friend std::ostream& operator<<(std::ostream& out, const PolarPoint& p)
+    friend std::ostream& operator<<(std::ostream& out, const BasicPolarPoint& p)
     {
         out << "radius: " << p.getRadius() << "\ttheta: " << p.getTheta();
         return out;
     }
 
-    static std::string GetDataAsString(const PolarPoint& p)
+    static std::string GetDataAsString(const BasicPolarPoint& p)
+    {
+        std::string result;
+        FormatTo(std::back_inserter(result), p);
+        return result;
+    }
+
+    // Same text as GetDataAsString, written into a caller's buffer
+    template <typename OutputIt>
+    static OutputIt FormatTo(OutputIt out, const BasicPolarPoint& p)
     {
-        return std::format("radius: {:.2f}\ttheta: {:.2f}\n", p.getRadius(), p.getTheta());
+        return std::format_to(out, "radius: {:.2f}\ttheta: {:.2f}\n", p.getRadius(), p.getTheta());
     }
 
-    [[nodiscard]] double getRadius() const { return m_radius; }
-    [[nodiscard]] double getTheta() const { return m_theta; }
-private:
-    const double m_radius, m_theta;
+    friend constexpr bool operator==(const BasicPolarPoint&, const BasicPolarPoint&) = default;
+
+    [[nodiscard]] constexpr T getRadius() const { return radius; }
+    [[nodiscard]] constexpr T getTheta() const { return theta; }
+
+    T radius{}, theta{};
 };
 
+using PolarPoint = BasicPolarPoint<double>;
+
 template <typename T>
 class CartesianPoint2D
 {
 public:
-    CartesianPoint2D(T x, T y)
-        : m_x{ x }, m_y{ y }
-    {}
-
-    static CartesianPoint2D fromPolar(const PolarPoint& p)
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr CartesianPoint2D fromPolar(const BasicPolarPoint<U>& p)
     {
-        T x = p.getRadius() * std::cos(p.getTheta());
-        T y = p.getRadius() * std::sin(p.getTheta());
+        using Real = typename Math::Real;
+        const Real radius { static_cast<Real>(p.getRadius()) };
+        Real sin, cos;
+        Math::sinCos(static_cast<Real>(p.getTheta()), sin, cos);
+
+        T x = radius * cos;
+        T y = radius * sin;
         return {x, y};
     }
 
@@ -64,74 +91,218 @@ public:
 
     static std::string GetDataAsString(const CartesianPoint2D& p)
     {
-        return std::format("x: {:.2f}\ty: {:.2f}\n", p.getX(), p.getY());
+        std::string result;
+        FormatTo(std::back_inserter(result), p);
+        return result;
+    }
+
+    template <typename OutputIt>
+    static OutputIt FormatTo(OutputIt out, const CartesianPoint2D& p)
+    {
+        return std::format_to(out, "x: {:.2f}\ty: {:.2f}\n", p.getX(), p.getY());
     }
 
-    [[nodiscard]] T getX() const { return m_x; }
-    [[nodiscard]] T getY() const { return m_y; }
-private:
-    const T m_x, m_y;
+    friend constexpr bool operator==(const CartesianPoint2D&, const CartesianPoint2D&) = default;
+
+    friend constexpr CartesianPoint2D operator+(const CartesianPoint2D& a, const CartesianPoint2D& b) { return { a.x + b.x, a.y + b.y }; }
+    friend constexpr CartesianPoint2D operator-(const CartesianPoint2D& a, const CartesianPoint2D& b) { return { a.x - b.x, a.y - b.y }; }
+    friend constexpr CartesianPoint2D operator-(const CartesianPoint2D& a) { return { -a.x, -a.y }; }
+    friend constexpr CartesianPoint2D operator*(const CartesianPoint2D& a, const T s) { return { a.x * s, a.y * s }; }
+    friend constexpr CartesianPoint2D operator*(const T s, const CartesianPoint2D& a) { return a * s; }
+    friend constexpr CartesianPoint2D operator/(const CartesianPoint2D& a, const T s) { return { a.x / s, a.y / s }; }
+
+    constexpr CartesianPoint2D& operator+=(const CartesianPoint2D& b) { return *this = *this + b; }
+    constexpr CartesianPoint2D& operator-=(const CartesianPoint2D& b) { return *this = *this - b; }
+    constexpr CartesianPoint2D& operator*=(const T s) { return *this = *this * s; }
+    constexpr CartesianPoint2D& operator/=(const T s) { return *this = *this / s; }
+
+    friend constexpr T dot(const CartesianPoint2D& a, const CartesianPoint2D& b) { return a.x * b.x + a.y * b.y; }
+    // z of the 3D cross product, positive when b is counterclockwise from a
+    friend constexpr T cross(const CartesianPoint2D& a, const CartesianPoint2D& b) { return a.x * b.y - a.y * b.x; }
+    friend constexpr T squaredNorm(const CartesianPoint2D& a) { return dot(a, a); }
+    friend constexpr T norm(const CartesianPoint2D& a) { return std::sqrt(squaredNorm(a)); }
+
+    [[nodiscard]] constexpr T getX() const { return x; }
+    [[nodiscard]] constexpr T getY() const { return y; }
+
+    T x{}, y{};
 };
 
 template <typename T>
 class CartesianPoint3D;
 
+template <typename T>
+class BasicCylindricalPoint;
+
 // Radius - це радіус-вектор rho
 // azimuth - це азимутальний кут theta
 // polarAngle = полярний кут phi
 //
-class SphericalPoint
+template <typename T>
+class BasicSphericalPoint
 {
 public:
-    SphericalPoint(double radius, double azimuth, double polarAngle)
-        : m_rho{ radius }, m_theta{ azimuth }, m_polarAngle{ polarAngle }
-    {}
-
-    template <typename T>
-    static SphericalPoint fromCartesian(const CartesianPoint3D<T>& p)
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr BasicSphericalPoint fromCartesian(const CartesianPoint3D<U>& p)
     {
-        const double radius { std::sqrt(std::pow(p.getX(), 2) + std::pow(p.getY(), 2) + std::pow(p.getZ(), 2)) };
+        using Real = typename Math::Real;
+        const Real x { static_cast<Real>(p.getX()) };
+        const Real y { static_cast<Real>(p.getY()) };
+        const Real z { static_cast<Real>(p.getZ()) };
+
+        const Real radius { Math::sqrt(x * x + y * y + z * z) };
 
         if(radius == 0)
-            return {0.0, 0.0, 0.0};
+            return {0, 0, 0};
+
+        const T theta = Math::atan2(y, x);
+        const T phi = Math::acos(z / radius);
+
+        return { static_cast<T>(radius), theta, phi };
+    }
 
-        const double theta { std::atan2(p.getY(), p.getX()) };
-        const double phi { std::acos(p.getZ() / radius) };
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr BasicSphericalPoint fromCylindrical(const BasicCylindricalPoint<U>& p)
+    {
+        using Real = typename Math::Real;
+        const Real rho { static_cast<Real>(p.getRadius()) };
+        const Real z { static_cast<Real>(p.getZ()) };
 
-        return { radius, theta, phi };
+        // atan2(rho, z) is acos(z / radius) without the division, and gives 0 at the origin
+        const T radius = Math::sqrt(rho * rho + z * z);
+        const T phi = Math::atan2(rho, z);
+        return { radius, static_cast<T>(p.getTheta()), phi };
     }
 
-    friend std::ostream& operator<<(std::ostream& out, const SphericalPoint& p)
+    friend std::ostream& operator<<(std::ostream& out, const BasicSphericalPoint& p)
     {
         out << "radius: " << p.getRadius() << "\ttheta: " << p.getTheta() << "\tphi: " << p.getPolarAngle();
         return out;
     }
 
-    static std::string GetDataAsString(const SphericalPoint& p)
+    static std::string GetDataAsString(const BasicSphericalPoint& p)
+    {
+        std::string result;
+        FormatTo(std::back_inserter(result), p);
+        return result;
+    }
+
+    template <typename OutputIt>
+    static OutputIt FormatTo(OutputIt out, const BasicSphericalPoint& p)
+    {
+        return std::format_to(out, "radius: {:.2f}\ttheta: {:.2f}\tphi: {:.2f}", p.getRadius(), p.getTheta(), p.getPolarAngle());
+    }
+
+    friend constexpr bool operator==(const BasicSphericalPoint&, const BasicSphericalPoint&) = default;
+
+    [[nodiscard]] constexpr T getRadius() const { return radius; }
+    [[nodiscard]] constexpr T getTheta() const { return theta; }
+    [[nodiscard]] constexpr T getPolarAngle() const { return polarAngle; }
+
+    T radius{}, theta{}, polarAngle{};
+};
+
+using SphericalPoint = BasicSphericalPoint<double>;
+
+// Radius - відстань до осі z rho
+// azimuth - це азимутальний кут theta
+// z - висота
+//
+template <typename T>
+class BasicCylindricalPoint
+{
+public:
+    static constexpr BasicCylindricalPoint fromPolar(const BasicPolarPoint<T>& p, T height)
+    {
+        return { p.getRadius(), p.getTheta(), height };
+    }
+
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr BasicCylindricalPoint fromCartesian(const CartesianPoint3D<U>& p)
+    {
+        using Real = typename Math::Real;
+        const Real x { static_cast<Real>(p.getX()) };
+        const Real y { static_cast<Real>(p.getY()) };
+
+        const T radius = Math::sqrt(x * x + y * y);
+        const T theta = Math::atan2(y, x);
+        return { radius, theta, static_cast<T>(p.getZ()) };
+    }
+
+    // The azimuth is shared with spherical coordinates, only the polar angle needs trig
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr BasicCylindricalPoint fromSpherical(const BasicSphericalPoint<U>& p)
+    {
+        using Real = typename Math::Real;
+        const Real radius { static_cast<Real>(p.getRadius()) };
+        Real sinPhi, cosPhi;
+        Math::sinCos(static_cast<Real>(p.getPolarAngle()), sinPhi, cosPhi);
+
+        const T rho = radius * sinPhi;
+        const T z = radius * cosPhi;
+        return { rho, static_cast<T>(p.getTheta()), z };
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const BasicCylindricalPoint& p)
+    {
+        out << "radius: " << p.getRadius() << "\ttheta: " << p.getTheta() << "\tz: " << p.getZ();
+        return out;
+    }
+
+    static std::string GetDataAsString(const BasicCylindricalPoint& p)
+    {
+        std::string result;
+        FormatTo(std::back_inserter(result), p);
+        return result;
+    }
+
+    template <typename OutputIt>
+    static OutputIt FormatTo(OutputIt out, const BasicCylindricalPoint& p)
     {
-        return std::format("radius: {:.2f}\ttheta: {:.2f}\tphi: {:.2f}", p.getRadius(), p.getTheta(), p.getPolarAngle());
+        return std::format_to(out, "radius: {:.2f}\ttheta: {:.2f}\tz: {:.2f}", p.getRadius(), p.getTheta(), p.getZ());
     }
 
-    [[nodiscard]] double getRadius() const { return m_rho; }
-    [[nodiscard]] double getTheta() const { return m_theta; }
-    [[nodiscard]] double getPolarAngle() const { return m_polarAngle; }
-private:
-    const double m_rho, m_theta, m_polarAngle;
+    friend constexpr bool operator==(const BasicCylindricalPoint&, const BasicCylindricalPoint&) = default;
+
+    [[nodiscard]] constexpr T getRadius() const { return radius; }
+    [[nodiscard]] constexpr T getTheta() const { return theta; }
+    [[nodiscard]] constexpr T getZ() const { return z; }
+
+    T radius{}, theta{}, z{};
 };
 
+using CylindricalPoint = BasicCylindricalPoint<double>;
+
 template <typename T>
 class CartesianPoint3D
 {
 public:
-    CartesianPoint3D(T x, T y, T z)
-        : m_x{ x }, m_y{ y }, m_z{ z }
-    {}
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr CartesianPoint3D fromSpherical(const BasicSphericalPoint<U>& p)
+    {
+        using Real = typename Math::Real;
+        const Real radius { static_cast<Real>(p.getRadius()) };
+        Real sinPhi, cosPhi, sinTheta, cosTheta;
+        Math::sinCos(static_cast<Real>(p.getPolarAngle()), sinPhi, cosPhi);
+        Math::sinCos(static_cast<Real>(p.getTheta()), sinTheta, cosTheta);
+
+        T x = radius * sinPhi * cosTheta;
+        T y = radius * sinPhi * sinTheta;
+        T z = radius * cosPhi;
+        return {x, y, z};
+    }
 
-    static CartesianPoint3D fromSpherical(const SphericalPoint& p)
+    template <typename Math = Coord::ExactMath, typename U>
+    static constexpr CartesianPoint3D fromCylindrical(const BasicCylindricalPoint<U>& p)
     {
-        T x = p.getRadius() * std::sin(p.getPolarAngle()) * std::cos(p.getTheta());
-        T y = p.getRadius() * std::sin(p.getPolarAngle()) * std::sin(p.getTheta());
-        T z = p.getRadius() * std::cos(p.getPolarAngle());
+        using Real = typename Math::Real;
+        const Real radius { static_cast<Real>(p.getRadius()) };
+        Real sinTheta, cosTheta;
+        Math::sinCos(static_cast<Real>(p.getTheta()), sinTheta, cosTheta);
+
+        T x = radius * cosTheta;
+        T y = radius * sinTheta;
+        T z = static_cast<T>(p.getZ());
         return {x, y, z};
     }
 
@@ -143,15 +314,119 @@ public:
 
     static std::string GetDataAsString(const CartesianPoint3D& p)
     {
-        return std::format("x: {:.2f}\ty: {:.2f}\tz: {:.2f}", p.getX(), p.getY(), p.getZ());
+        std::string result;
+        FormatTo(std::back_inserter(result), p);
+        return result;
+    }
+
+    template <typename OutputIt>
+    static OutputIt FormatTo(OutputIt out, const CartesianPoint3D& p)
+    {
+        return std::format_to(out, "x: {:.2f}\ty: {:.2f}\tz: {:.2f}", p.getX(), p.getY(), p.getZ());
+    }
+
+    friend constexpr bool operator==(const CartesianPoint3D&, const CartesianPoint3D&) = default;
+
+    friend constexpr CartesianPoint3D operator+(const CartesianPoint3D& a, const CartesianPoint3D& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    friend constexpr CartesianPoint3D operator-(const CartesianPoint3D& a, const CartesianPoint3D& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    friend constexpr CartesianPoint3D operator-(const CartesianPoint3D& a) { return { -a.x, -a.y, -a.z }; }
+    friend constexpr CartesianPoint3D operator*(const CartesianPoint3D& a, const T s) { return { a.x * s, a.y * s, a.z * s }; }
+    friend constexpr CartesianPoint3D operator*(const T s, const CartesianPoint3D& a) { return a * s; }
+    friend constexpr CartesianPoint3D operator/(const CartesianPoint3D& a, const T s) { return { a.x / s, a.y / s, a.z / s }; }
+
+    constexpr CartesianPoint3D& operator+=(const CartesianPoint3D& b) { return *this = *this + b; }
+    constexpr CartesianPoint3D& operator-=(const CartesianPoint3D& b) { return *this = *this - b; }
+    constexpr CartesianPoint3D& operator*=(const T s) { return *this = *this * s; }
+    constexpr CartesianPoint3D& operator/=(const T s) { return *this = *this / s; }
+
+    friend constexpr T dot(const CartesianPoint3D& a, const CartesianPoint3D& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    friend constexpr CartesianPoint3D cross(const CartesianPoint3D& a, const CartesianPoint3D& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    friend constexpr T squaredNorm(const CartesianPoint3D& a) { return dot(a, a); }
+    friend constexpr T norm(const CartesianPoint3D& a) { return std::sqrt(squaredNorm(a)); }
+
+    [[nodiscard]] constexpr T getX() const { return x; }
+    [[nodiscard]] constexpr T getY() const { return y; }
+    [[nodiscard]] constexpr T getZ() const { return z; }
+
+    T x{}, y{}, z{};
+};
+
+// Bulk code copies points with memcpy and keeps them in reused buffers
+static_assert(std::is_aggregate_v<PolarPoint> && std::is_trivially_copyable_v<PolarPoint>);
+static_assert(std::is_aggregate_v<SphericalPoint> && std::is_trivially_copyable_v<SphericalPoint>);
+static_assert(std::is_aggregate_v<CylindricalPoint> && std::is_trivially_copyable_v<CylindricalPoint>);
+static_assert(std::is_aggregate_v<CartesianPoint2D<double>> && std::is_trivially_copyable_v<CartesianPoint2D<double>>);
+static_assert(std::is_aggregate_v<CartesianPoint3D<double>> && std::is_trivially_copyable_v<CartesianPoint3D<double>>);
+static_assert(sizeof(CartesianPoint3D<float>) == 3 * sizeof(float));
+
+// std::format support. The format spec applies to every coordinate: std::format("{:.3f}", p)
+template <typename T>
+struct std::formatter<BasicPolarPoint<T>> : std::formatter<T>
+{
+    auto format(const BasicPolarPoint<T>& p, std::format_context& ctx) const
+    {
+        ctx.advance_to(std::format_to(ctx.out(), "radius: "));
+        ctx.advance_to(std::formatter<T>::format(p.getRadius(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\ttheta: "));
+        return std::formatter<T>::format(p.getTheta(), ctx);
+    }
+};
+
+template <typename T>
+struct std::formatter<CartesianPoint2D<T>> : std::formatter<T>
+{
+    auto format(const CartesianPoint2D<T>& p, std::format_context& ctx) const
+    {
+        ctx.advance_to(std::format_to(ctx.out(), "x: "));
+        ctx.advance_to(std::formatter<T>::format(p.getX(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\ty: "));
+        return std::formatter<T>::format(p.getY(), ctx);
+    }
+};
+
+template <typename T>
+struct std::formatter<BasicSphericalPoint<T>> : std::formatter<T>
+{
+    auto format(const BasicSphericalPoint<T>& p, std::format_context& ctx) const
+    {
+        ctx.advance_to(std::format_to(ctx.out(), "radius: "));
+        ctx.advance_to(std::formatter<T>::format(p.getRadius(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\ttheta: "));
+        ctx.advance_to(std::formatter<T>::format(p.getTheta(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\tphi: "));
+        return std::formatter<T>::format(p.getPolarAngle(), ctx);
     }
+};
 
-    [[nodiscard]] T getX() const { return m_x; }
-    [[nodiscard]] T getY() const { return m_y; }
-    [[nodiscard]] T getZ() const { return m_z; }
+template <typename T>
+struct std::formatter<BasicCylindricalPoint<T>> : std::formatter<T>
+{
+    auto format(const BasicCylindricalPoint<T>& p, std::format_context& ctx) const
+    {
+        ctx.advance_to(std::format_to(ctx.out(), "radius: "));
+        ctx.advance_to(std::formatter<T>::format(p.getRadius(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\ttheta: "));
+        ctx.advance_to(std::formatter<T>::format(p.getTheta(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\tz: "));
+        return std::formatter<T>::format(p.getZ(), ctx);
+    }
+};
 
-private:
-    const T m_x, m_y, m_z;
+template <typename T>
+struct std::formatter<CartesianPoint3D<T>> : std::formatter<T>
+{
+    auto format(const CartesianPoint3D<T>& p, std::format_context& ctx) const
+    {
+        ctx.advance_to(std::format_to(ctx.out(), "x: "));
+        ctx.advance_to(std::formatter<T>::format(p.getX(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\ty: "));
+        ctx.advance_to(std::formatter<T>::format(p.getY(), ctx));
+        ctx.advance_to(std::format_to(ctx.out(), "\tz: "));
+        return std::formatter<T>::format(p.getZ(), ctx);
+    }
 };
 
 #endif //LB2_COORDINATESYSTEMS_H
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "BatchConversions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/Simd/ConversionKernels.h"
+
+#if COORD_SIMD_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Coord
+{
+    namespace
+    {
+        void polarToCartesianScalar(const double* radius, const double* theta, double* x, double* y, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto c { CartesianPoint2D<double>::fromPolar(PolarPoint{ radius[i], theta[i] }) };
+                x[i] = c.getX();
+                y[i] = c.getY();
+            }
+        }
+
+        void cartesianToPolarScalar(const double* x, const double* y, double* radius, double* theta, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const PolarPoint p { PolarPoint::fromCartesian(CartesianPoint2D<double>{ x[i], y[i] }) };
+                radius[i] = p.getRadius();
+                theta[i] = p.getTheta();
+            }
+        }
+
+        void sphericalToCartesianScalar(const double* radius, const double* theta, const double* polarAngle,
+                                        double* x, double* y, double* z, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto c { CartesianPoint3D<double>::fromSpherical(SphericalPoint{ radius[i], theta[i], polarAngle[i] }) };
+                x[i] = c.getX();
+                y[i] = c.getY();
+                z[i] = c.getZ();
+            }
+        }
+
+        void cartesianToSphericalScalar(const double* x, const double* y, const double* z,
+                                        double* radius, double* theta, double* polarAngle, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const SphericalPoint s { SphericalPoint::fromCartesian(CartesianPoint3D<double>{ x[i], y[i], z[i] }) };
+                radius[i] = s.getRadius();
+                theta[i] = s.getTheta();
+                polarAngle[i] = s.getPolarAngle();
+            }
+        }
+
+        constexpr Simd::ConversionKernels s_scalarKernels {
+            &polarToCartesianScalar,
+            &cartesianToPolarScalar,
+            &sphericalToCartesianScalar,
+            &cartesianToSphericalScalar
+        };
+
+        const Simd::ConversionKernels* kernelsFor(const SimdLevel level)
+        {
+            switch (level)
+            {
+                case SimdLevel::AVX512: return Simd::getAVX512Kernels();
+                case SimdLevel::AVX2:   return Simd::getAVX2Kernels();
+                case SimdLevel::SSE42:  return Simd::getSSE42Kernels();
+                case SimdLevel::Scalar: return &s_scalarKernels;
+            }
+            return &s_scalarKernels;
+        }
+
+        bool cpuSupports(const SimdLevel level)
+        {
+#if COORD_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+            // libgcc also checks that the OS saves the wider registers (XGETBV)
+            __builtin_cpu_init();
+            switch (level)
+            {
+                case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+                case SimdLevel::AVX2:   return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                case SimdLevel::SSE42:  return __builtin_cpu_supports("sse4.2");
+                case SimdLevel::Scalar: return true;
+            }
+            return false;
+#elif COORD_SIMD_X86 && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            const int maxLeaf { info[0] };
+
+            __cpuid(info, 1);
+            const bool sse42 { (info[2] & (1 << 20)) != 0 };
+            const bool fma { (info[2] & (1 << 12)) != 0 };
+            const bool osxsave { (info[2] & (1 << 27)) != 0 };
+            const unsigned long long xcr0 { osxsave ? _xgetbv(0) : 0 };
+            const bool osAvx { (xcr0 & 0x6) == 0x6 };
+            const bool osAvx512 { (xcr0 & 0xE6) == 0xE6 };
+
+            int extended[4] { 0, 0, 0, 0 };
+            if (maxLeaf >= 7)
+                __cpuidex(extended, 7, 0);
+            const bool avx2 { (extended[1] & (1 << 5)) != 0 };
+            const bool avx512f { (extended[1] & (1 << 16)) != 0 };
+
+            switch (level)
+            {
+                case SimdLevel::AVX512: return avx512f && osAvx512;
+                case SimdLevel::AVX2:   return avx2 && fma && osAvx;
+                case SimdLevel::SSE42:  return sse42;
+                case SimdLevel::Scalar: return true;
+            }
+            return false;
+#else
+            return level == SimdLevel::Scalar;
+#endif
+        }
+
+        SimdLevel clampToSupported(SimdLevel level)
+        {
+            while (level != SimdLevel::Scalar && (!cpuSupports(level) || !kernelsFor(level)))
+                level = static_cast<SimdLevel>(static_cast<int>(level) - 1);
+            return level;
+        }
+
+        std::atomic<SimdLevel>& activeLevel()
+        {
+            static std::atomic<SimdLevel> s_level { detectSimdLevel() };
+            return s_level;
+        }
+
+        // Levels the CPU lacks fall back like setSimdLevel() would, without changing the level of everyone else
+        const Simd::ConversionKernels& kernelsAt(const SimdLevel level)
+        {
+            const Simd::ConversionKernels* kernels { kernelsFor(std::min(level, detectSimdLevel())) };
+            return kernels ? *kernels : s_scalarKernels;
+        }
+    }
+
+    SimdLevel detectSimdLevel()
+    {
+        static const SimdLevel s_detected { clampToSupported(SimdLevel::AVX512) };
+        return s_detected;
+    }
+
+    SimdLevel getSimdLevel()
+    {
+        return activeLevel().load();
+    }
+
+    void setSimdLevel(const SimdLevel level)
+    {
+        activeLevel().store(clampToSupported(level));
+    }
+
+    const char* toString(const SimdLevel level)
+    {
+        switch (level)
+        {
+            case SimdLevel::AVX512: return "AVX-512";
+            case SimdLevel::AVX2:   return "AVX2";
+            case SimdLevel::SSE42:  return "SSE4.2";
+            case SimdLevel::Scalar: return "Scalar";
+        }
+        return "Unknown";
+    }
+
+    namespace Batch
+    {
+        void polarToCartesian(std::span<const double> radius, std::span<const double> theta,
+                              std::span<double> x, std::span<double> y)
+        {
+            polarToCartesian(getSimdLevel(), radius, theta, x, y);
+        }
+
+        void polarToCartesian(const SimdLevel level, std::span<const double> radius, std::span<const double> theta,
+                              std::span<double> x, std::span<double> y)
+        {
+            assert(theta.size() == radius.size() && x.size() == radius.size() && y.size() == radius.size());
+            kernelsAt(level).polarToCartesian(radius.data(), theta.data(), x.data(), y.data(), radius.size());
+        }
+
+        void cartesianToPolar(std::span<const double> x, std::span<const double> y,
+                              std::span<double> radius, std::span<double> theta)
+        {
+            cartesianToPolar(getSimdLevel(), x, y, radius, theta);
+        }
+
+        void cartesianToPolar(const SimdLevel level, std::span<const double> x, std::span<const double> y,
+                              std::span<double> radius, std::span<double> theta)
+        {
+            assert(y.size() == x.size() && radius.size() == x.size() && theta.size() == x.size());
+            kernelsAt(level).cartesianToPolar(x.data(), y.data(), radius.data(), theta.data(), x.size());
+        }
+
+        void sphericalToCartesian(std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                                  std::span<double> x, std::span<double> y, std::span<double> z)
+        {
+            sphericalToCartesian(getSimdLevel(), radius, theta, polarAngle, x, y, z);
+        }
+
+        void sphericalToCartesian(const SimdLevel level, std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                                  std::span<double> x, std::span<double> y, std::span<double> z)
+        {
+            assert(theta.size() == radius.size() && polarAngle.size() == radius.size());
+            assert(x.size() == radius.size() && y.size() == radius.size() && z.size() == radius.size());
+            kernelsAt(level).sphericalToCartesian(radius.data(), theta.data(), polarAngle.data(),
+                                                  x.data(), y.data(), z.data(), radius.size());
+        }
+
+        void cartesianToSpherical(std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                                  std::span<double> radius, std::span<double> theta, std::span<double> polarAngle)
+        {
+            cartesianToSpherical(getSimdLevel(), x, y, z, radius, theta, polarAngle);
+        }
+
+        void cartesianToSpherical(const SimdLevel level, std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                                  std::span<double> radius, std::span<double> theta, std::span<double> polarAngle)
+        {
+            assert(y.size() == x.size() && z.size() == x.size());
+            assert(radius.size() == x.size() && theta.size() == x.size() && polarAngle.size() == x.size());
+            kernelsAt(level).cartesianToSpherical(x.data(), y.data(), z.data(),
+                                                  radius.data(), theta.data(), polarAngle.data(), x.size());
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef COORDSYSTEM_BATCHCONVERSIONS_H
+#define COORDSYSTEM_BATCHCONVERSIONS_H
+
+#include <span>
+
+// Vectorized bulk versions of the conversions from CoordinateSystems.h over contiguous columns.
+// The kernel is picked at runtime from what the CPU supports: AVX-512, AVX2, SSE4.2 or a scalar
+// fallback that calls the point conversions. Vector kernels use polynomial sin/cos/atan2 and
+// differ from libm by at most a few ULP for finite input.
+namespace Coord
+{
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE42,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * @return Best instruction set that's compiled in and supported by this CPU (checked via CPUID)
+     */
+    [[nodiscard]] SimdLevel detectSimdLevel();
+
+    [[nodiscard]] SimdLevel getSimdLevel();
+
+    /**
+     * @param level Instruction set the batch functions should use. Levels above detectSimdLevel() are clamped
+     */
+    void setSimdLevel(SimdLevel level);
+
+    [[nodiscard]] const char* toString(SimdLevel level);
+
+    namespace Batch
+    {
+        // All columns of one call must have the same size. Output must not overlap input.
+        // The overloads taking a level run at that level instead of getSimdLevel() and leave it unchanged,
+        // e.g. to compare the kernels while other code keeps using the batch functions. Levels above
+        // detectSimdLevel() are clamped
+        void polarToCartesian(std::span<const double> radius, std::span<const double> theta,
+                              std::span<double> x, std::span<double> y);
+        void polarToCartesian(SimdLevel level, std::span<const double> radius, std::span<const double> theta,
+                              std::span<double> x, std::span<double> y);
+
+        void cartesianToPolar(std::span<const double> x, std::span<const double> y,
+                              std::span<double> radius, std::span<double> theta);
+        void cartesianToPolar(SimdLevel level, std::span<const double> x, std::span<const double> y,
+                              std::span<double> radius, std::span<double> theta);
+
+        void sphericalToCartesian(std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                                  std::span<double> x, std::span<double> y, std::span<double> z);
+        void sphericalToCartesian(SimdLevel level, std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                                  std::span<double> x, std::span<double> y, std::span<double> z);
+
+        void cartesianToSpherical(std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                                  std::span<double> radius, std::span<double> theta, std::span<double> polarAngle);
+        void cartesianToSpherical(SimdLevel level, std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                                  std::span<double> radius, std::span<double> theta, std::span<double> polarAngle);
+    }
+}
+
+#endif //COORDSYSTEM_BATCHCONVERSIONS_H
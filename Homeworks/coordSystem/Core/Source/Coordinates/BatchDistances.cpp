@@ -0,0 +1,381 @@
+#include "BatchDistances.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/Distance.h"
+#include "Coordinates/Simd/DistanceKernels.h"
+
+namespace Coord::Batch
+{
+    namespace
+    {
+        void cartesian2DScalar(const double* x1, const double* y1, const double* x2, const double* y2,
+                               double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance2DCartesian(CartesianPoint2D<double>{ x1[i], y1[i] }, CartesianPoint2D<double>{ x2[i], y2[i] });
+        }
+
+        void cartesian3DScalar(const double* x1, const double* y1, const double* z1,
+                               const double* x2, const double* y2, const double* z2, double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DCartesian(CartesianPoint3D<double>{ x1[i], y1[i], z1[i] },
+                                                    CartesianPoint3D<double>{ x2[i], y2[i], z2[i] });
+        }
+
+        void polar2DScalar(const double* radius1, const double* theta1, const double* radius2, const double* theta2,
+                           double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance2DPolar(PolarPoint{ radius1[i], theta1[i] }, PolarPoint{ radius2[i], theta2[i] });
+        }
+
+        void chordScalar(const double* radius1, const double* theta1, const double* polarAngle1,
+                         const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DChord(SphericalPoint{ radius1[i], theta1[i], polarAngle1[i] },
+                                                SphericalPoint{ radius2[i], theta2[i], polarAngle2[i] });
+        }
+
+        void arcScalar(const double* radius1, const double* theta1, const double* polarAngle1,
+                       const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DArc(SphericalPoint{ radius1[i], theta1[i], polarAngle1[i] },
+                                              SphericalPoint{ radius2[i], theta2[i], polarAngle2[i] });
+        }
+
+        void cartesian2DFromScalar(const double* from, const double* x, const double* y, double* out, std::size_t count)
+        {
+            const CartesianPoint2D<double> p { from[0], from[1] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance2DCartesian(p, CartesianPoint2D<double>{ x[i], y[i] });
+        }
+
+        void cartesian3DFromScalar(const double* from, const double* x, const double* y, const double* z,
+                                   double* out, std::size_t count)
+        {
+            const CartesianPoint3D<double> p { from[0], from[1], from[2] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DCartesian(p, CartesianPoint3D<double>{ x[i], y[i], z[i] });
+        }
+
+        void polar2DFromScalar(const double* from, const double* radius, const double* theta, double* out, std::size_t count)
+        {
+            const PolarPoint p { from[0], from[1] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance2DPolar(p, PolarPoint{ radius[i], theta[i] });
+        }
+
+        void chordFromScalar(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                             double* out, std::size_t count)
+        {
+            const SphericalPoint p { from[0], from[1], from[2] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DChord(p, SphericalPoint{ radius[i], theta[i], polarAngle[i] });
+        }
+
+        void arcFromScalar(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                           double* out, std::size_t count)
+        {
+            const SphericalPoint p { from[0], from[1], from[2] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DArc(p, SphericalPoint{ radius[i], theta[i], polarAngle[i] });
+        }
+
+        void greatCircleScalar(const double* radius1, const double* theta1, const double* polarAngle1,
+                               const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DGreatCircle(SphericalPoint{ radius1[i], theta1[i], polarAngle1[i] },
+                                                      SphericalPoint{ radius2[i], theta2[i], polarAngle2[i] });
+        }
+
+        void haversineScalar(const double* radius1, const double* theta1, const double* polarAngle1,
+                             const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DHaversine(SphericalPoint{ radius1[i], theta1[i], polarAngle1[i] },
+                                                    SphericalPoint{ radius2[i], theta2[i], polarAngle2[i] });
+        }
+
+        void greatCircleFromScalar(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                                   double* out, std::size_t count)
+        {
+            const SphericalPoint p { from[0], from[1], from[2] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DGreatCircle(p, SphericalPoint{ radius[i], theta[i], polarAngle[i] });
+        }
+
+        void haversineFromScalar(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                                 double* out, std::size_t count)
+        {
+            const SphericalPoint p { from[0], from[1], from[2] };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DHaversine(p, SphericalPoint{ radius[i], theta[i], polarAngle[i] });
+        }
+
+        void preparedChordFromScalar(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                     double* out, std::size_t count)
+        {
+            const PreparedSphericalPoint<double> p { from[0], { from[1], from[2], from[3] } };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DChord(p, PreparedSphericalPoint<double>{ radius[i], { x[i], y[i], z[i] } });
+        }
+
+        void preparedArcFromScalar(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                   double* out, std::size_t count)
+        {
+            const PreparedSphericalPoint<double> p { from[0], { from[1], from[2], from[3] } };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = Coord::distance3DArc(p, PreparedSphericalPoint<double>{ radius[i], { x[i], y[i], z[i] } });
+        }
+
+        constexpr Simd::DistanceKernels s_scalarKernels {
+            &cartesian2DScalar,
+            &cartesian3DScalar,
+            &polar2DScalar,
+            &chordScalar,
+            &arcScalar,
+            &cartesian2DFromScalar,
+            &cartesian3DFromScalar,
+            &polar2DFromScalar,
+            &chordFromScalar,
+            &arcFromScalar,
+            &greatCircleScalar,
+            &haversineScalar,
+            &greatCircleFromScalar,
+            &haversineFromScalar,
+            &preparedChordFromScalar,
+            &preparedArcFromScalar
+        };
+
+        // The distance kernels live in the translation units of the conversion kernels,
+        // so every level setSimdLevel() accepts has them. Higher levels are clamped the same way
+        const Simd::DistanceKernels& kernelsAt(const SimdLevel level)
+        {
+            const Simd::DistanceKernels* kernels { nullptr };
+            switch (std::min(level, detectSimdLevel()))
+            {
+                case SimdLevel::AVX512: kernels = Simd::getAVX512DistanceKernels(); break;
+                case SimdLevel::AVX2:   kernels = Simd::getAVX2DistanceKernels(); break;
+                case SimdLevel::SSE42:  kernels = Simd::getSSE42DistanceKernels(); break;
+                case SimdLevel::Scalar: break;
+            }
+            return kernels ? *kernels : s_scalarKernels;
+        }
+    }
+
+    void distance2DCartesian(std::span<const double> x1, std::span<const double> y1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<double> out)
+    {
+        distance2DCartesian(getSimdLevel(), x1, y1, x2, y2, out);
+    }
+
+    void distance2DCartesian(const SimdLevel level, std::span<const double> x1, std::span<const double> y1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<double> out)
+    {
+        assert(y1.size() == x1.size() && x2.size() == x1.size() && y2.size() == x1.size() && out.size() == x1.size());
+        kernelsAt(level).cartesian2D(x1.data(), y1.data(), x2.data(), y2.data(), out.data(), out.size());
+    }
+
+    void distance3DCartesian(std::span<const double> x1, std::span<const double> y1, std::span<const double> z1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<const double> z2,
+                             std::span<double> out)
+    {
+        distance3DCartesian(getSimdLevel(), x1, y1, z1, x2, y2, z2, out);
+    }
+
+    void distance3DCartesian(const SimdLevel level, std::span<const double> x1, std::span<const double> y1, std::span<const double> z1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<const double> z2,
+                             std::span<double> out)
+    {
+        assert(y1.size() == x1.size() && z1.size() == x1.size() && out.size() == x1.size());
+        assert(x2.size() == x1.size() && y2.size() == x1.size() && z2.size() == x1.size());
+        kernelsAt(level).cartesian3D(x1.data(), y1.data(), z1.data(), x2.data(), y2.data(), z2.data(), out.data(), out.size());
+    }
+
+    void distance2DPolar(std::span<const double> radius1, std::span<const double> theta1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<double> out)
+    {
+        distance2DPolar(getSimdLevel(), radius1, theta1, radius2, theta2, out);
+    }
+
+    void distance2DPolar(const SimdLevel level, std::span<const double> radius1, std::span<const double> theta1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<double> out)
+    {
+        assert(theta1.size() == radius1.size() && radius2.size() == radius1.size());
+        assert(theta2.size() == radius1.size() && out.size() == radius1.size());
+        kernelsAt(level).polar2D(radius1.data(), theta1.data(), radius2.data(), theta2.data(), out.data(), out.size());
+    }
+
+    void distance3DChord(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                         std::span<double> out)
+    {
+        distance3DChord(getSimdLevel(), radius1, theta1, polarAngle1, radius2, theta2, polarAngle2, out);
+    }
+
+    void distance3DChord(const SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                         std::span<double> out)
+    {
+        assert(theta1.size() == radius1.size() && polarAngle1.size() == radius1.size() && out.size() == radius1.size());
+        assert(radius2.size() == radius1.size() && theta2.size() == radius1.size() && polarAngle2.size() == radius1.size());
+        kernelsAt(level).chord(radius1.data(), theta1.data(), polarAngle1.data(),
+                               radius2.data(), theta2.data(), polarAngle2.data(), out.data(), out.size());
+    }
+
+    void distance3DArc(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                       std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                       std::span<double> out)
+    {
+        distance3DArc(getSimdLevel(), radius1, theta1, polarAngle1, radius2, theta2, polarAngle2, out);
+    }
+
+    void distance3DArc(const SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                       std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                       std::span<double> out)
+    {
+        assert(theta1.size() == radius1.size() && polarAngle1.size() == radius1.size() && out.size() == radius1.size());
+        assert(radius2.size() == radius1.size() && theta2.size() == radius1.size() && polarAngle2.size() == radius1.size());
+        kernelsAt(level).arc(radius1.data(), theta1.data(), polarAngle1.data(),
+                             radius2.data(), theta2.data(), polarAngle2.data(), out.data(), out.size());
+    }
+
+    void distance3DGreatCircle(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                               std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                               std::span<double> out, const GreatCircleFormula formula)
+    {
+        distance3DGreatCircle(getSimdLevel(), radius1, theta1, polarAngle1, radius2, theta2, polarAngle2, out, formula);
+    }
+
+    void distance3DGreatCircle(const SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                               std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                               std::span<double> out, const GreatCircleFormula formula)
+    {
+        assert(theta1.size() == radius1.size() && polarAngle1.size() == radius1.size() && out.size() == radius1.size());
+        assert(radius2.size() == radius1.size() && theta2.size() == radius1.size() && polarAngle2.size() == radius1.size());
+        const Simd::DistanceKernels& kernels { kernelsAt(level) };
+        (formula == GreatCircleFormula::Vincenty ? kernels.greatCircle : kernels.haversine)(
+            radius1.data(), theta1.data(), polarAngle1.data(), radius2.data(), theta2.data(), polarAngle2.data(), out.data(), out.size());
+    }
+
+    void distance2DCartesian(const CartesianPoint2D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<double> out)
+    {
+        distance2DCartesian(getSimdLevel(), from, x, y, out);
+    }
+
+    void distance2DCartesian(const SimdLevel level, const CartesianPoint2D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<double> out)
+    {
+        assert(y.size() == x.size() && out.size() == x.size());
+        const double coordinates[] { from.getX(), from.getY() };
+        kernelsAt(level).cartesian2DFrom(coordinates, x.data(), y.data(), out.data(), out.size());
+    }
+
+    void distance3DCartesian(const CartesianPoint3D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<const double> z, std::span<double> out)
+    {
+        distance3DCartesian(getSimdLevel(), from, x, y, z, out);
+    }
+
+    void distance3DCartesian(const SimdLevel level, const CartesianPoint3D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<const double> z, std::span<double> out)
+    {
+        assert(y.size() == x.size() && z.size() == x.size() && out.size() == x.size());
+        const double coordinates[] { from.getX(), from.getY(), from.getZ() };
+        kernelsAt(level).cartesian3DFrom(coordinates, x.data(), y.data(), z.data(), out.data(), out.size());
+    }
+
+    void distance2DPolar(const PolarPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<double> out)
+    {
+        distance2DPolar(getSimdLevel(), from, radius, theta, out);
+    }
+
+    void distance2DPolar(const SimdLevel level, const PolarPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<double> out)
+    {
+        assert(theta.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.getRadius(), from.getTheta() };
+        kernelsAt(level).polar2DFrom(coordinates, radius.data(), theta.data(), out.data(), out.size());
+    }
+
+    void distance3DChord(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<const double> polarAngle, std::span<double> out)
+    {
+        distance3DChord(getSimdLevel(), from, radius, theta, polarAngle, out);
+    }
+
+    void distance3DChord(const SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<const double> polarAngle, std::span<double> out)
+    {
+        assert(theta.size() == radius.size() && polarAngle.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.getRadius(), from.getTheta(), from.getPolarAngle() };
+        kernelsAt(level).chordFrom(coordinates, radius.data(), theta.data(), polarAngle.data(), out.data(), out.size());
+    }
+
+    void distance3DArc(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                       std::span<const double> polarAngle, std::span<double> out)
+    {
+        distance3DArc(getSimdLevel(), from, radius, theta, polarAngle, out);
+    }
+
+    void distance3DArc(const SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                       std::span<const double> polarAngle, std::span<double> out)
+    {
+        assert(theta.size() == radius.size() && polarAngle.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.getRadius(), from.getTheta(), from.getPolarAngle() };
+        kernelsAt(level).arcFrom(coordinates, radius.data(), theta.data(), polarAngle.data(), out.data(), out.size());
+    }
+
+    void distance3DGreatCircle(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                               std::span<const double> polarAngle, std::span<double> out, const GreatCircleFormula formula)
+    {
+        distance3DGreatCircle(getSimdLevel(), from, radius, theta, polarAngle, out, formula);
+    }
+
+    void distance3DGreatCircle(const SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                               std::span<const double> polarAngle, std::span<double> out, const GreatCircleFormula formula)
+    {
+        assert(theta.size() == radius.size() && polarAngle.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.getRadius(), from.getTheta(), from.getPolarAngle() };
+        const Simd::DistanceKernels& kernels { kernelsAt(level) };
+        (formula == GreatCircleFormula::Vincenty ? kernels.greatCircleFrom : kernels.haversineFrom)(
+            coordinates, radius.data(), theta.data(), polarAngle.data(), out.data(), out.size());
+    }
+
+    void distance3DChord(const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                         std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out)
+    {
+        distance3DChord(getSimdLevel(), from, radius, x, y, z, out);
+    }
+
+    void distance3DChord(const SimdLevel level, const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                         std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out)
+    {
+        assert(x.size() == radius.size() && y.size() == radius.size() && z.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.radius, from.unit.x, from.unit.y, from.unit.z };
+        kernelsAt(level).preparedChordFrom(coordinates, radius.data(), x.data(), y.data(), z.data(), out.data(), out.size());
+    }
+
+    void distance3DArc(const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                       std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out)
+    {
+        distance3DArc(getSimdLevel(), from, radius, x, y, z, out);
+    }
+
+    void distance3DArc(const SimdLevel level, const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                       std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out)
+    {
+        assert(x.size() == radius.size() && y.size() == radius.size() && z.size() == radius.size() && out.size() == radius.size());
+        const double coordinates[] { from.radius, from.unit.x, from.unit.y, from.unit.z };
+        kernelsAt(level).preparedArcFrom(coordinates, radius.data(), x.data(), y.data(), z.data(), out.data(), out.size());
+    }
+}
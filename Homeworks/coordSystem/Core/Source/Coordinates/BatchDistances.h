@@ -0,0 +1,113 @@
+#ifndef COORDSYSTEM_BATCHDISTANCES_H
+#define COORDSYSTEM_BATCHDISTANCES_H
+
+#include <span>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/PreparedSpherical.h"
+
+// Bulk versions of the distances from Distance.h over contiguous columns, dispatched on getSimdLevel()
+// like the batch conversions. The scalar level calls the point functions of Distance.h and is the
+// reference the vector kernels are checked against.
+namespace Coord::Batch
+{
+    enum class GreatCircleFormula
+    {
+        // distance3DGreatCircle, full precision at every separation
+        Vincenty,
+        // distance3DHaversine with a cheaper sine, precise for short arcs
+        Haversine
+    };
+
+    // Pairwise: out[i] is the distance between point i of the first and point i of the second set.
+    // All columns of one call must have the same size. Output must not overlap input.
+    // The overloads taking a level run at it instead of getSimdLevel(), see the batch conversions
+
+    void distance2DCartesian(std::span<const double> x1, std::span<const double> y1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<double> out);
+    void distance2DCartesian(SimdLevel level, std::span<const double> x1, std::span<const double> y1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<double> out);
+
+    void distance3DCartesian(std::span<const double> x1, std::span<const double> y1, std::span<const double> z1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<const double> z2,
+                             std::span<double> out);
+    void distance3DCartesian(SimdLevel level, std::span<const double> x1, std::span<const double> y1, std::span<const double> z1,
+                             std::span<const double> x2, std::span<const double> y2, std::span<const double> z2,
+                             std::span<double> out);
+
+    void distance2DPolar(std::span<const double> radius1, std::span<const double> theta1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<double> out);
+    void distance2DPolar(SimdLevel level, std::span<const double> radius1, std::span<const double> theta1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<double> out);
+
+    void distance3DChord(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                         std::span<double> out);
+    void distance3DChord(SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                         std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                         std::span<double> out);
+
+    void distance3DArc(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                       std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                       std::span<double> out);
+    void distance3DArc(SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                       std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                       std::span<double> out);
+
+    // The quantity of distance3DArc without acos, see GreatCircleFormula
+    void distance3DGreatCircle(std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                               std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                               std::span<double> out, GreatCircleFormula formula = GreatCircleFormula::Vincenty);
+    void distance3DGreatCircle(SimdLevel level, std::span<const double> radius1, std::span<const double> theta1, std::span<const double> polarAngle1,
+                               std::span<const double> radius2, std::span<const double> theta2, std::span<const double> polarAngle2,
+                               std::span<double> out, GreatCircleFormula formula = GreatCircleFormula::Vincenty);
+
+    // One-to-many: out[i] is the distance from "from" to point i
+
+    void distance2DCartesian(const CartesianPoint2D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<double> out);
+    void distance2DCartesian(SimdLevel level, const CartesianPoint2D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<double> out);
+
+    void distance3DCartesian(const CartesianPoint3D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<const double> z, std::span<double> out);
+    void distance3DCartesian(SimdLevel level, const CartesianPoint3D<double>& from, std::span<const double> x, std::span<const double> y,
+                             std::span<const double> z, std::span<double> out);
+
+    void distance2DPolar(const PolarPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<double> out);
+    void distance2DPolar(SimdLevel level, const PolarPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<double> out);
+
+    void distance3DChord(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<const double> polarAngle, std::span<double> out);
+    void distance3DChord(SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                         std::span<const double> polarAngle, std::span<double> out);
+
+    void distance3DArc(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                       std::span<const double> polarAngle, std::span<double> out);
+    void distance3DArc(SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                       std::span<const double> polarAngle, std::span<double> out);
+
+    void distance3DGreatCircle(const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                               std::span<const double> polarAngle, std::span<double> out,
+                               GreatCircleFormula formula = GreatCircleFormula::Vincenty);
+    void distance3DGreatCircle(SimdLevel level, const SphericalPoint& from, std::span<const double> radius, std::span<const double> theta,
+                               std::span<const double> polarAngle, std::span<double> out,
+                               GreatCircleFormula formula = GreatCircleFormula::Vincenty);
+
+    // One-to-many over the columns of a PreparedSphericalArray: radius and unit vector components
+
+    void distance3DChord(const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                         std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out);
+    void distance3DChord(SimdLevel level, const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                         std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out);
+
+    void distance3DArc(const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                       std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out);
+    void distance3DArc(SimdLevel level, const PreparedSphericalPoint<double>& from, std::span<const double> radius,
+                       std::span<const double> x, std::span<const double> y, std::span<const double> z, std::span<double> out);
+}
+
+#endif //COORDSYSTEM_BATCHDISTANCES_H
@@ -0,0 +1,146 @@
+#include "BatchTransforms.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/Simd/TransformKernels.h"
+
+namespace Coord::Batch
+{
+    namespace
+    {
+        Affine2D<double> toAffine2D(const double* matrix)
+        {
+            Affine2D<double> a;
+            std::copy_n(matrix, a.matrix.size(), a.matrix.begin());
+            return a;
+        }
+
+        Affine3D<double> toAffine3D(const double* matrix)
+        {
+            Affine3D<double> a;
+            std::copy_n(matrix, a.matrix.size(), a.matrix.begin());
+            return a;
+        }
+
+        void affine2DScalar(const double* matrix, const double* x, const double* y, double* outX, double* outY, std::size_t count)
+        {
+            const Affine2D<double> a { toAffine2D(matrix) };
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const CartesianPoint2D<double> p { a({ x[i], y[i] }) };
+                outX[i] = p.x;
+                outY[i] = p.y;
+            }
+        }
+
+        void affine3DScalar(const double* matrix, const double* x, const double* y, const double* z,
+                            double* outX, double* outY, double* outZ, std::size_t count)
+        {
+            const Affine3D<double> a { toAffine3D(matrix) };
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const CartesianPoint3D<double> p { a({ x[i], y[i], z[i] }) };
+                outX[i] = p.x;
+                outY[i] = p.y;
+                outZ[i] = p.z;
+            }
+        }
+
+        void polarAffine2DScalar(const double* matrix, const double* radius, const double* theta,
+                                 double* outX, double* outY, std::size_t count)
+        {
+            const Affine2D<double> a { toAffine2D(matrix) };
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const CartesianPoint2D<double> p { a(CartesianPoint2D<double>::fromPolar(PolarPoint{ radius[i], theta[i] })) };
+                outX[i] = p.x;
+                outY[i] = p.y;
+            }
+        }
+
+        void sphericalAffine3DScalar(const double* matrix, const double* radius, const double* theta, const double* polarAngle,
+                                     double* outX, double* outY, double* outZ, std::size_t count)
+        {
+            const Affine3D<double> a { toAffine3D(matrix) };
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const SphericalPoint s { radius[i], theta[i], polarAngle[i] };
+                const CartesianPoint3D<double> p { a(CartesianPoint3D<double>::fromSpherical(s)) };
+                outX[i] = p.x;
+                outY[i] = p.y;
+                outZ[i] = p.z;
+            }
+        }
+
+        constexpr Simd::TransformKernels s_scalarKernels {
+            &affine2DScalar,
+            &affine3DScalar,
+            &polarAffine2DScalar,
+            &sphericalAffine3DScalar
+        };
+
+        const Simd::TransformKernels& kernelsAt(const SimdLevel level)
+        {
+            const Simd::TransformKernels* kernels { nullptr };
+            switch (std::min(level, detectSimdLevel()))
+            {
+                case SimdLevel::AVX512: kernels = Simd::getAVX512TransformKernels(); break;
+                case SimdLevel::AVX2:   kernels = Simd::getAVX2TransformKernels(); break;
+                case SimdLevel::SSE42:  kernels = Simd::getSSE42TransformKernels(); break;
+                case SimdLevel::Scalar: break;
+            }
+            return kernels ? *kernels : s_scalarKernels;
+        }
+    }
+
+    void transform(const Affine2D<double>& transform, Cartesian2DSpan<const double> in, Cartesian2DSpan<double> out)
+    {
+        Batch::transform(getSimdLevel(), transform, in, out);
+    }
+
+    void transform(const SimdLevel level, const Affine2D<double>& transform, Cartesian2DSpan<const double> in, Cartesian2DSpan<double> out)
+    {
+        assert(in.y.size() == in.size() && out.x.size() == in.size() && out.y.size() == in.size());
+        kernelsAt(level).affine2D(transform.matrix.data(), in.x.data(), in.y.data(), out.x.data(), out.y.data(), in.size());
+    }
+
+    void transform(const Affine3D<double>& transform, Cartesian3DSpan<const double> in, Cartesian3DSpan<double> out)
+    {
+        Batch::transform(getSimdLevel(), transform, in, out);
+    }
+
+    void transform(const SimdLevel level, const Affine3D<double>& transform, Cartesian3DSpan<const double> in, Cartesian3DSpan<double> out)
+    {
+        assert(in.y.size() == in.size() && in.z.size() == in.size());
+        assert(out.x.size() == in.size() && out.y.size() == in.size() && out.z.size() == in.size());
+        kernelsAt(level).affine3D(transform.matrix.data(), in.x.data(), in.y.data(), in.z.data(),
+                                  out.x.data(), out.y.data(), out.z.data(), in.size());
+    }
+
+    void transform(const Affine2D<double>& transform, PolarSpan<const double> in, Cartesian2DSpan<double> out)
+    {
+        Batch::transform(getSimdLevel(), transform, in, out);
+    }
+
+    void transform(const SimdLevel level, const Affine2D<double>& transform, PolarSpan<const double> in, Cartesian2DSpan<double> out)
+    {
+        assert(in.theta.size() == in.size() && out.x.size() == in.size() && out.y.size() == in.size());
+        kernelsAt(level).polarAffine2D(transform.matrix.data(), in.radius.data(), in.theta.data(),
+                                       out.x.data(), out.y.data(), in.size());
+    }
+
+    void transform(const Affine3D<double>& transform, SphericalSpan<const double> in, Cartesian3DSpan<double> out)
+    {
+        Batch::transform(getSimdLevel(), transform, in, out);
+    }
+
+    void transform(const SimdLevel level, const Affine3D<double>& transform, SphericalSpan<const double> in, Cartesian3DSpan<double> out)
+    {
+        assert(in.theta.size() == in.size() && in.polarAngle.size() == in.size());
+        assert(out.x.size() == in.size() && out.y.size() == in.size() && out.z.size() == in.size());
+        kernelsAt(level).sphericalAffine3D(transform.matrix.data(), in.radius.data(), in.theta.data(), in.polarAngle.data(),
+                                           out.x.data(), out.y.data(), out.z.data(), in.size());
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef COORDSYSTEM_BATCHTRANSFORMS_H
+#define COORDSYSTEM_BATCHTRANSFORMS_H
+
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/PointArrays.h"
+#include "Coordinates/Transform.h"
+
+// Affine2D/Affine3D applied to whole point arrays, dispatched on getSimdLevel() like the batch
+// conversions. Compose a chain of transforms first (see Affine3D::then) and pass the result, every
+// point then costs one multiply-add per matrix element. The scalar level calls the point transforms
+// of Transform.h and is the reference the vector kernels are checked against.
+namespace Coord::Batch
+{
+    // Input and output must have the same size. Output may be the input view, partial overlap isn't allowed.
+    // The overloads taking a level run at it instead of getSimdLevel(), see the batch conversions
+
+    void transform(const Affine2D<double>& transform, Cartesian2DSpan<const double> in, Cartesian2DSpan<double> out);
+    void transform(SimdLevel level, const Affine2D<double>& transform, Cartesian2DSpan<const double> in, Cartesian2DSpan<double> out);
+
+    void transform(const Affine3D<double>& transform, Cartesian3DSpan<const double> in, Cartesian3DSpan<double> out);
+    void transform(SimdLevel level, const Affine3D<double>& transform, Cartesian3DSpan<const double> in, Cartesian3DSpan<double> out);
+
+    // Points in the local polar/spherical frame of a sensor straight to the frame transform maps to,
+    // without storing the local Cartesian points in between
+
+    void transform(const Affine2D<double>& transform, PolarSpan<const double> in, Cartesian2DSpan<double> out);
+    void transform(SimdLevel level, const Affine2D<double>& transform, PolarSpan<const double> in, Cartesian2DSpan<double> out);
+
+    void transform(const Affine3D<double>& transform, SphericalSpan<const double> in, Cartesian3DSpan<double> out);
+    void transform(SimdLevel level, const Affine3D<double>& transform, SphericalSpan<const double> in, Cartesian3DSpan<double> out);
+}
+
+#endif //COORDSYSTEM_BATCHTRANSFORMS_H
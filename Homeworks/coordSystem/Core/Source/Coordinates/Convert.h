@@ -0,0 +1,227 @@
+#ifndef COORDSYSTEM_CONVERT_H
+#define COORDSYSTEM_CONVERT_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/MathPolicy.h"
+
+// Generic conversion between any two point types: Coord::convert<SphericalPoint>(polar).
+//
+// The point types are nodes of a graph whose edges are the direct conversions below. The shortest
+// path is found at compile time and the hops are chained inline, so a multi-hop conversion costs
+// only the formulas on the path. Direct edges that skip Cartesian coordinates (cylindrical <-> spherical,
+// the 2D -> 3D embeddings) keep the azimuth as is instead of recomputing it with sin/cos and atan2.
+namespace Coord
+{
+    /**
+     * Direct conversion From -> To, an edge of the conversion graph.
+     * Specializations provide template <typename Math> static To apply(const From&).
+     */
+    template <typename From, typename To>
+    struct Conversion;
+
+    // Points of the graph. Cartesian points take part in double precision
+    using ConvertiblePoints = std::tuple<PolarPoint, CartesianPoint2D<double>,
+                                         CylindricalPoint, SphericalPoint, CartesianPoint3D<double>>;
+
+    template <>
+    struct Conversion<CartesianPoint2D<double>, PolarPoint>
+    {
+        template <typename Math>
+        static PolarPoint apply(const CartesianPoint2D<double>& p) { return PolarPoint::fromCartesian<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<PolarPoint, CartesianPoint2D<double>>
+    {
+        template <typename Math>
+        static CartesianPoint2D<double> apply(const PolarPoint& p) { return CartesianPoint2D<double>::fromPolar<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<CartesianPoint3D<double>, SphericalPoint>
+    {
+        template <typename Math>
+        static SphericalPoint apply(const CartesianPoint3D<double>& p) { return SphericalPoint::fromCartesian<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<SphericalPoint, CartesianPoint3D<double>>
+    {
+        template <typename Math>
+        static CartesianPoint3D<double> apply(const SphericalPoint& p) { return CartesianPoint3D<double>::fromSpherical<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<CartesianPoint3D<double>, CylindricalPoint>
+    {
+        template <typename Math>
+        static CylindricalPoint apply(const CartesianPoint3D<double>& p) { return CylindricalPoint::fromCartesian<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<CylindricalPoint, CartesianPoint3D<double>>
+    {
+        template <typename Math>
+        static CartesianPoint3D<double> apply(const CylindricalPoint& p) { return CartesianPoint3D<double>::fromCylindrical<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<CylindricalPoint, SphericalPoint>
+    {
+        template <typename Math>
+        static SphericalPoint apply(const CylindricalPoint& p) { return SphericalPoint::fromCylindrical<Math>(p); }
+    };
+
+    template <>
+    struct Conversion<SphericalPoint, CylindricalPoint>
+    {
+        template <typename Math>
+        static CylindricalPoint apply(const SphericalPoint& p) { return CylindricalPoint::fromSpherical<Math>(p); }
+    };
+
+    // 2D points lie in the z = 0 plane. There are no edges back, dropping z is up to the caller
+    template <>
+    struct Conversion<PolarPoint, CylindricalPoint>
+    {
+        template <typename Math>
+        static CylindricalPoint apply(const PolarPoint& p) { return CylindricalPoint::fromPolar(p, 0.0); }
+    };
+
+    template <>
+    struct Conversion<CartesianPoint2D<double>, CartesianPoint3D<double>>
+    {
+        template <typename Math>
+        static CartesianPoint3D<double> apply(const CartesianPoint2D<double>& p) { return { p.getX(), p.getY(), 0.0 }; }
+    };
+
+    namespace Detail
+    {
+        template <typename From, typename To>
+        concept HasConversion = requires(const From& from)
+        {
+            { Conversion<From, To>::template apply<ExactMath>(from) } -> std::same_as<To>;
+        };
+
+        template <typename Points>
+        struct ConversionGraph;
+
+        template <typename... Points>
+        struct ConversionGraph<std::tuple<Points...>>
+        {
+            static constexpr std::size_t kSize { sizeof...(Points) };
+
+            template <typename From>
+            static constexpr std::array<bool, kSize> kEdgesFrom { HasConversion<From, Points>... };
+            static constexpr std::array<std::array<bool, kSize>, kSize> kEdges { kEdgesFrom<Points>... };
+
+            template <typename P>
+            static constexpr std::size_t indexOf()
+            {
+                std::size_t i { 0 };
+                ((std::is_same_v<P, Points> ? false : (++i, true)) && ...);
+                return i;
+            }
+
+            template <typename P>
+            static constexpr bool contains { indexOf<P>() < kSize };
+
+            template <std::size_t I>
+            using PointAt = std::tuple_element_t<I, std::tuple<Points...>>;
+        };
+
+        // Node indices from source to target, length 0 if the target can't be reached
+        template <std::size_t N>
+        struct ConversionPath
+        {
+            std::array<std::size_t, N> nodes{};
+            std::size_t length{ 0 };
+        };
+
+        template <std::size_t N>
+        constexpr ConversionPath<N> shortestPath(const std::array<std::array<bool, N>, N>& edges,
+                                                 const std::size_t from, const std::size_t to)
+        {
+            // Breadth-first search, so the path with the fewest hops wins
+            std::array<std::size_t, N> previous{};
+            std::array<bool, N> visited{};
+            std::array<std::size_t, N> queue{};
+            std::size_t head { 0 }, tail { 0 };
+
+            visited[from] = true;
+            queue[tail++] = from;
+            while (head < tail && !visited[to])
+            {
+                const std::size_t node { queue[head++] };
+                for (std::size_t next = 0; next < N; ++next)
+                {
+                    if (edges[node][next] && !visited[next])
+                    {
+                        visited[next] = true;
+                        previous[next] = node;
+                        queue[tail++] = next;
+                    }
+                }
+            }
+
+            ConversionPath<N> path;
+            if (!visited[to])
+                return path;
+
+            std::array<std::size_t, N> reversed{};
+            for (std::size_t node = to; ; node = previous[node])
+            {
+                reversed[path.length++] = node;
+                if (node == from)
+                    break;
+            }
+            for (std::size_t i = 0; i < path.length; ++i)
+                path.nodes[i] = reversed[path.length - 1 - i];
+            return path;
+        }
+
+        using Graph = ConversionGraph<ConvertiblePoints>;
+
+        template <typename From, typename To>
+        inline constexpr ConversionPath<Graph::kSize> kPath { shortestPath(Graph::kEdges, Graph::indexOf<From>(), Graph::indexOf<To>()) };
+
+        template <typename Math, const auto& Path, std::size_t Step, typename Point>
+        auto walk(const Point& p)
+        {
+            if constexpr (Step + 1 == Path.length)
+                return p;
+            else
+            {
+                using Next = Graph::PointAt<Path.nodes[Step + 1]>;
+                return walk<Math, Path, Step + 1>(Conversion<Point, Next>::template apply<Math>(p));
+            }
+        }
+    }
+
+    /**
+     * @return Number of direct conversions convert<To>(From) chains, 0 for the same type
+     */
+    template <typename From, typename To>
+    inline constexpr std::size_t conversionHops { Detail::kPath<From, To>.length - 1 };
+
+    template <typename From, typename To>
+    concept ConvertibleTo = Detail::Graph::contains<From> && Detail::Graph::contains<To>
+                            && Detail::kPath<From, To>.length > 0;
+
+    /**
+     * @tparam Math Math policy used by every hop, see MathPolicy.h
+     */
+    template <typename To, typename Math = ExactMath, typename From>
+        requires ConvertibleTo<From, To>
+    To convert(const From& from)
+    {
+        return Detail::walk<Math, Detail::kPath<From, To>, 0>(from);
+    }
+}
+
+#endif //COORDSYSTEM_CONVERT_H
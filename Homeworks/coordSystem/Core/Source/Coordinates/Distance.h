@@ -0,0 +1,125 @@
+#ifndef COORDSYSTEM_DISTANCE_H
+#define COORDSYSTEM_DISTANCE_H
+
+#include <algorithm>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/MathPolicy.h"
+
+// Distances between points of the same coordinate system.
+// Math selects the implementation of the roots and trig functions, see MathPolicy.h.
+namespace Coord
+{
+    template <typename Math = ExactMath, typename T>
+    double distance2DCartesian(const CartesianPoint2D<T>& p1, const CartesianPoint2D<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real x = static_cast<Real>(p2.getX() - p1.getX());
+        const Real y = static_cast<Real>(p2.getY() - p1.getY());
+        return Math::sqrt(x * x + y * y);
+    }
+
+    template <typename Math = ExactMath, typename T>
+    double distance3DCartesian(const CartesianPoint3D<T>& p1, const CartesianPoint3D<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real x = static_cast<Real>(p2.getX() - p1.getX());
+        const Real y = static_cast<Real>(p2.getY() - p1.getY());
+        const Real z = static_cast<Real>(p2.getZ() - p1.getZ());
+        return Math::sqrt(x * x + y * y + z * z);
+    }
+
+    template <typename Math = ExactMath, typename T>
+    double distance2DPolar(const BasicPolarPoint<T>& p1, const BasicPolarPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real r1 = static_cast<Real>(p1.getRadius());
+        const Real r2 = static_cast<Real>(p2.getRadius());
+        const Real theta = static_cast<Real>(p2.getTheta() - p1.getTheta());
+
+        return Math::sqrt(std::max(r1 * r1 + r2 * r2 - 2 * r1 * r2 * Math::cos(theta), Real(0)));
+    }
+
+    template <typename Math = ExactMath, typename T>
+    double distance3DChord(const BasicSphericalPoint<T>& p1, const BasicSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real r1 = static_cast<Real>(p1.getRadius());
+        const Real r2 = static_cast<Real>(p2.getRadius());
+
+        Real sinTheta1, cosTheta1, sinTheta2, cosTheta2;
+        Math::sinCos(static_cast<Real>(p1.getPolarAngle()), sinTheta1, cosTheta1);
+        Math::sinCos(static_cast<Real>(p2.getPolarAngle()), sinTheta2, cosTheta2);
+        const Real cosPhi = Math::cos(static_cast<Real>(p1.getTheta() - p2.getTheta()));
+
+        // Rounding can leave the square slightly negative for equal points
+        return Math::sqrt(std::max(r1 * r1 + r2 * r2 - 2 * r1 * r2 * (
+                          sinTheta1 * sinTheta2 * cosPhi
+                          + cosTheta1 * cosTheta2
+        ), Real(0)));
+    }
+
+    template <typename Math = ExactMath, typename T>
+    double distance3DArc(const BasicSphericalPoint<T>& p1, const BasicSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real radius = static_cast<Real>((p1.getRadius() + p2.getRadius()) / 2.0);
+
+        Real sinPhi1, cosPhi1, sinPhi2, cosPhi2;
+        Math::sinCos(static_cast<Real>(p1.getPolarAngle()), sinPhi1, cosPhi1);
+        Math::sinCos(static_cast<Real>(p2.getPolarAngle()), sinPhi2, cosPhi2);
+        const Real cosTheta = Math::cos(static_cast<Real>(p1.getTheta() - p2.getTheta()));
+
+        // ... and the cosine slightly past 1
+        return radius * Math::acos(std::clamp(
+            sinPhi1 * sinPhi2
+            * cosTheta
+            + cosPhi1 * cosPhi2,
+            Real(-1), Real(1)
+        ));
+    }
+
+    /**
+     * The quantity of distance3DArc, angle between the directions times the mean radius, with the angle
+     * taken from atan2 of its sine and cosine (Vincenty's formula). Keeps full precision for nearby and
+     * for opposite points, where acos of the cosine loses up to half of the digits.
+     */
+    template <typename Math = ExactMath, typename T>
+    double distance3DGreatCircle(const BasicSphericalPoint<T>& p1, const BasicSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real radius = static_cast<Real>((p1.getRadius() + p2.getRadius()) / 2.0);
+
+        Real sinPhi1, cosPhi1, sinPhi2, cosPhi2, sinHalfTheta, cosHalfTheta;
+        Math::sinCos(static_cast<Real>(p1.getPolarAngle()), sinPhi1, cosPhi1);
+        Math::sinCos(static_cast<Real>(p2.getPolarAngle()), sinPhi2, cosPhi2);
+        Math::sinCos(static_cast<Real>(p2.getTheta() - p1.getTheta()) / 2, sinHalfTheta, cosHalfTheta);
+
+        // 1 - cos(dTheta) as 2 sin^2(dTheta / 2), so "along" doesn't cancel for nearby points
+        const Real versine = 2 * sinHalfTheta * sinHalfTheta;
+        const Real across = sinPhi2 * 2 * sinHalfTheta * cosHalfTheta;
+        const Real along = Math::sin(static_cast<Real>(p1.getPolarAngle() - p2.getPolarAngle())) + cosPhi1 * sinPhi2 * versine;
+        const Real cosine = cosPhi1 * cosPhi2 + sinPhi1 * sinPhi2 * (1 - versine);
+        return radius * Math::atan2(Math::sqrt(across * across + along * along), cosine);
+    }
+
+    /**
+     * distance3DGreatCircle from the haversine of the angle: only sines, precise for short arcs,
+     * loses precision close to opposite points
+     */
+    template <typename Math = ExactMath, typename T>
+    double distance3DHaversine(const BasicSphericalPoint<T>& p1, const BasicSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real radius = static_cast<Real>((p1.getRadius() + p2.getRadius()) / 2.0);
+
+        const Real sinHalfPhi = Math::sin(static_cast<Real>(p2.getPolarAngle() - p1.getPolarAngle()) / 2);
+        const Real sinHalfTheta = Math::sin(static_cast<Real>(p2.getTheta() - p1.getTheta()) / 2);
+        const Real sinPhis = Math::sin(static_cast<Real>(p1.getPolarAngle())) * Math::sin(static_cast<Real>(p2.getPolarAngle()));
+
+        const Real haversine = std::clamp(sinHalfPhi * sinHalfPhi + sinPhis * sinHalfTheta * sinHalfTheta, Real(0), Real(1));
+        return radius * 2 * Math::atan2(Math::sqrt(haversine), Math::sqrt(1 - haversine));
+    }
+}
+
+#endif //COORDSYSTEM_DISTANCE_H
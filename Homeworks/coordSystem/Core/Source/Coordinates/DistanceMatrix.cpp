@@ -0,0 +1,216 @@
+#include "DistanceMatrix.h"
+
+#include <algorithm>
+#include <future>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Core/ThreadPool.h"
+#include "Coordinates/BatchDistances.h"
+#include "Coordinates/PreparedSpherical.h"
+
+namespace Coord
+{
+    namespace
+    {
+        /**
+         * Computes rows [firstRow, firstRow + rowCount) into band, which starts at the first stored entry of firstRow.
+         * kernel(row, firstColumn, count, out) writes the distances from row to count columns into out.
+         */
+        template <typename T, typename Kernel>
+        void computeBand(const std::size_t firstRow, const std::size_t rowCount, const std::size_t columns,
+                         const MatrixOptions& options, const Kernel& kernel, T* band)
+        {
+            const std::size_t tileRows { std::max(options.tileRows, std::size_t{ 1 }) };
+            const std::size_t tileColumns { std::max(options.tileColumns, std::size_t{ 1 }) };
+            const std::size_t rowTiles { (rowCount + tileRows - 1) / tileRows };
+            const std::size_t columnTiles { (columns + tileColumns - 1) / tileColumns };
+            const std::size_t bandOffset { matrixRowOffset(firstRow, columns, options.layout) };
+            const bool triangular { options.layout == MatrixLayout::UpperTriangular };
+
+            Core::ThreadPool& pool { options.pool ? *options.pool : Core::ThreadPool::Get() };
+
+            // Consecutive tiles share their rows, so a chunk of tiles walks along one band of rows
+            pool.ParallelFor(rowTiles * columnTiles, 1, [&](const std::size_t begin, const std::size_t end)
+            {
+                std::vector<double> scratch(std::is_same_v<T, double> ? 0 : tileColumns);
+
+                for (std::size_t tile = begin; tile < end; ++tile)
+                {
+                    const std::size_t rowBegin { firstRow + tile / columnTiles * tileRows };
+                    const std::size_t rowEnd { std::min(rowBegin + tileRows, firstRow + rowCount) };
+                    const std::size_t columnBegin { tile % columnTiles * tileColumns };
+                    const std::size_t columnEnd { std::min(columnBegin + tileColumns, columns) };
+
+                    for (std::size_t row = rowBegin; row < rowEnd; ++row)
+                    {
+                        // Triangular rows start right after the diagonal
+                        const std::size_t first { triangular ? std::max(columnBegin, row + 1) : columnBegin };
+                        if (first >= columnEnd)
+                            continue;
+
+                        const std::size_t count { columnEnd - first };
+                        T* out { band + matrixRowOffset(row, columns, options.layout) - bandOffset + (triangular ? first - row - 1 : first) };
+                        if constexpr (std::is_same_v<T, double>)
+                            kernel(row, first, count, out);
+                        else
+                        {
+                            kernel(row, first, count, scratch.data());
+                            std::transform(scratch.begin(), scratch.begin() + count, out, [](const double d) { return static_cast<T>(d); });
+                        }
+                    }
+                }
+            }, options.maxThreads);
+        }
+
+        template <typename T, typename Kernel>
+        DistanceMatrix<T> computeMatrix(const std::size_t rows, const std::size_t columns,
+                                        const MatrixOptions& options, const Kernel& kernel)
+        {
+            DistanceMatrix<T> matrix(rows, columns, options.layout);
+            computeBand(0, rows, columns, options, kernel, matrix.values().data());
+            return matrix;
+        }
+
+        template <typename T, typename Kernel>
+        void streamMatrix(const std::size_t rows, const std::size_t columns, const MatrixOptions& options,
+                          const MatrixSink<T>& sink, const Kernel& kernel)
+        {
+            checkMatrixShape(rows, columns, options.layout);
+            if (rows == 0)
+                return;
+
+            // Whole rows per band, at least one even if a single row is over the budget
+            const std::size_t rowBytes { std::max(columns, std::size_t{ 1 }) * sizeof(T) };
+            const std::size_t bandRows { std::clamp(options.bandBytes / rowBytes, std::size_t{ 1 }, rows) };
+
+            // The next band is computed while the sink still writes the previous one
+            std::vector<T> bands[2] { std::vector<T>(bandRows * columns), std::vector<T>(bandRows * columns) };
+            std::future<void> pending;
+            for (std::size_t firstRow = 0, band = 0; firstRow < rows; firstRow += bandRows, band ^= 1)
+            {
+                const std::size_t rowCount { std::min(bandRows, rows - firstRow) };
+                computeBand(firstRow, rowCount, columns, options, kernel, bands[band].data());
+
+                const std::size_t size { matrixRowOffset(firstRow + rowCount, columns, options.layout)
+                                         - matrixRowOffset(firstRow, columns, options.layout) };
+                if (pending.valid())
+                    pending.get();
+                pending = std::async(std::launch::async, [&sink, &values = bands[band], firstRow, rowCount, size]
+                {
+                    sink(firstRow, rowCount, std::span<const T>(values.data(), size));
+                });
+            }
+            pending.get();
+        }
+
+        auto cartesian2DKernel(const CartesianArray2D<double>& rows, const CartesianArray2D<double>& columns)
+        {
+            return [&rows, &columns](const std::size_t row, const std::size_t first, const std::size_t count, double* out)
+            {
+                Batch::distance2DCartesian(rows[row], columns.x().subspan(first, count), columns.y().subspan(first, count),
+                                           { out, count });
+            };
+        }
+
+        auto cartesian3DKernel(const CartesianArray3D<double>& rows, const CartesianArray3D<double>& columns)
+        {
+            return [&rows, &columns](const std::size_t row, const std::size_t first, const std::size_t count, double* out)
+            {
+                Batch::distance3DCartesian(rows[row], columns.x().subspan(first, count), columns.y().subspan(first, count),
+                                           columns.z().subspan(first, count), { out, count });
+            };
+        }
+
+        // Both sets are prepared once, so a tile costs a dot product per entry instead of three sin/cos
+        auto sphericalKernel(const PreparedSphericalArray<double>& rows, const PreparedSphericalArray<double>& columns,
+                             const SphericalMetric metric)
+        {
+            return [&rows, &columns, metric](const std::size_t row, const std::size_t first, const std::size_t count, double* out)
+            {
+                const auto radius { columns.radius().subspan(first, count) };
+                const auto x { columns.x().subspan(first, count) };
+                const auto y { columns.y().subspan(first, count) };
+                const auto z { columns.z().subspan(first, count) };
+                if (metric == SphericalMetric::Chord)
+                    Batch::distance3DChord(rows[row], radius, x, y, z, { out, count });
+                else
+                    Batch::distance3DArc(rows[row], radius, x, y, z, { out, count });
+            };
+        }
+    }
+
+    template <typename T>
+    MatrixSink<T> binaryMatrixSink(std::ostream& out)
+    {
+        return [&out](std::size_t, std::size_t, const std::span<const T> values)
+        {
+            if (!out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes())))
+                throw std::runtime_error("Writing the distance matrix failed");
+        };
+    }
+
+    namespace Matrix
+    {
+        template <typename T>
+        DistanceMatrix<T> distance2DCartesian(const CartesianArray2D<double>& rows, const CartesianArray2D<double>& columns,
+                                              const MatrixOptions& options)
+        {
+            return computeMatrix<T>(rows.size(), columns.size(), options, cartesian2DKernel(rows, columns));
+        }
+
+        template <typename T>
+        DistanceMatrix<T> distance3DCartesian(const CartesianArray3D<double>& rows, const CartesianArray3D<double>& columns,
+                                              const MatrixOptions& options)
+        {
+            return computeMatrix<T>(rows.size(), columns.size(), options, cartesian3DKernel(rows, columns));
+        }
+
+        template <typename T>
+        DistanceMatrix<T> distance3DSpherical(const SphericalArray<double>& rows, const SphericalArray<double>& columns,
+                                              const SphericalMetric metric, const MatrixOptions& options)
+        {
+            const auto preparedRows { PreparedSphericalArray<double>::fromSpherical(rows) };
+            const auto preparedColumns { PreparedSphericalArray<double>::fromSpherical(columns) };
+            return computeMatrix<T>(rows.size(), columns.size(), options, sphericalKernel(preparedRows, preparedColumns, metric));
+        }
+
+        template <typename T>
+        void distance2DCartesian(const CartesianArray2D<double>& rows, const CartesianArray2D<double>& columns,
+                                 const MatrixSink<T>& sink, const MatrixOptions& options)
+        {
+            streamMatrix<T>(rows.size(), columns.size(), options, sink, cartesian2DKernel(rows, columns));
+        }
+
+        template <typename T>
+        void distance3DCartesian(const CartesianArray3D<double>& rows, const CartesianArray3D<double>& columns,
+                                 const MatrixSink<T>& sink, const MatrixOptions& options)
+        {
+            streamMatrix<T>(rows.size(), columns.size(), options, sink, cartesian3DKernel(rows, columns));
+        }
+
+        template <typename T>
+        void distance3DSpherical(const SphericalArray<double>& rows, const SphericalArray<double>& columns,
+                                 const SphericalMetric metric, const MatrixSink<T>& sink, const MatrixOptions& options)
+        {
+            const auto preparedRows { PreparedSphericalArray<double>::fromSpherical(rows) };
+            const auto preparedColumns { PreparedSphericalArray<double>::fromSpherical(columns) };
+            streamMatrix<T>(rows.size(), columns.size(), options, sink, sphericalKernel(preparedRows, preparedColumns, metric));
+        }
+    }
+
+#define COORD_INSTANTIATE_DISTANCE_MATRIX(T) \
+    template MatrixSink<T> binaryMatrixSink<T>(std::ostream&); \
+    template DistanceMatrix<T> Matrix::distance2DCartesian<T>(const CartesianArray2D<double>&, const CartesianArray2D<double>&, const MatrixOptions&); \
+    template DistanceMatrix<T> Matrix::distance3DCartesian<T>(const CartesianArray3D<double>&, const CartesianArray3D<double>&, const MatrixOptions&); \
+    template DistanceMatrix<T> Matrix::distance3DSpherical<T>(const SphericalArray<double>&, const SphericalArray<double>&, SphericalMetric, const MatrixOptions&); \
+    template void Matrix::distance2DCartesian<T>(const CartesianArray2D<double>&, const CartesianArray2D<double>&, const MatrixSink<T>&, const MatrixOptions&); \
+    template void Matrix::distance3DCartesian<T>(const CartesianArray3D<double>&, const CartesianArray3D<double>&, const MatrixSink<T>&, const MatrixOptions&); \
+    template void Matrix::distance3DSpherical<T>(const SphericalArray<double>&, const SphericalArray<double>&, SphericalMetric, const MatrixSink<T>&, const MatrixOptions&);
+
+    COORD_INSTANTIATE_DISTANCE_MATRIX(double)
+    COORD_INSTANTIATE_DISTANCE_MATRIX(float)
+
+#undef COORD_INSTANTIATE_DISTANCE_MATRIX
+}
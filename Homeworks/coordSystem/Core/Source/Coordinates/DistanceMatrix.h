@@ -0,0 +1,166 @@
+#ifndef COORDSYSTEM_DISTANCEMATRIX_H
+#define COORDSYSTEM_DISTANCEMATRIX_H
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Coordinates/PointArrays.h"
+
+namespace Core
+{
+    class ThreadPool;
+}
+
+// All-pairs distances between two point sets. The matrix is computed in tiles of rows x columns:
+// the columns of a tile stay in L1/L2 while every row of the tile runs the one-to-many batch kernel
+// over them, and the tiles are spread over the thread pool. Matrices that don't fit in memory are
+// produced band by band and handed to a sink, e.g. one that writes them to a file.
+namespace Coord
+{
+    enum class MatrixLayout
+    {
+        // rows x columns, row-major
+        Full,
+        // Only the entries above the diagonal (column > row), row-major and packed. Needs a square matrix,
+        // for the distances within one set that's every pair once. Other shapes throw std::invalid_argument
+        UpperTriangular
+    };
+
+    enum class SphericalMetric
+    {
+        Chord,
+        Arc
+    };
+
+    struct MatrixOptions
+    {
+        MatrixLayout layout{ MatrixLayout::Full };
+        // Rows and columns of one tile, the columns of a tile should fit in L1 (3-4 columns of doubles)
+        std::size_t tileRows{ 64 };
+        std::size_t tileColumns{ 1024 };
+        // Bytes of matrix values kept in memory at once when streaming to a sink
+        std::size_t bandBytes{ std::size_t{ 64 } << 20 };
+        // nullptr uses Core::ThreadPool::Get()
+        Core::ThreadPool* pool{ nullptr };
+        // 0 uses every thread of the pool
+        std::size_t maxThreads{ 0 };
+    };
+
+    /**
+     * @return Number of stored entries of a rows x columns matrix
+     */
+    constexpr std::size_t matrixEntryCount(const std::size_t rows, const std::size_t columns, const MatrixLayout layout)
+    {
+        if (layout == MatrixLayout::Full)
+            return rows * columns;
+        return rows == 0 ? 0 : rows * (rows - 1) / 2;
+    }
+
+    // Throws std::invalid_argument for shapes the layout can't store
+    inline void checkMatrixShape(const std::size_t rows, const std::size_t columns, const MatrixLayout layout)
+    {
+        if (layout == MatrixLayout::UpperTriangular && rows != columns)
+            throw std::invalid_argument("An upper triangular distance matrix needs as many rows as columns");
+    }
+
+    /**
+     * @return Index of the first stored entry of row, the rows of both layouts are contiguous
+     */
+    constexpr std::size_t matrixRowOffset(const std::size_t row, const std::size_t columns, const MatrixLayout layout)
+    {
+        if (layout == MatrixLayout::Full)
+            return row * columns;
+        return row * columns - row * (row + 1) / 2;
+    }
+
+    template <typename T = double>
+    class DistanceMatrix
+    {
+    public:
+        DistanceMatrix() = default;
+        DistanceMatrix(const std::size_t rows, const std::size_t columns, const MatrixLayout layout)
+            : m_rows{ rows }, m_columns{ columns }, m_layout{ layout }
+        {
+            checkMatrixShape(rows, columns, layout);
+            m_values.resize(matrixEntryCount(rows, columns, layout));
+        }
+
+        // Triangular matrices mirror the entries below the diagonal and have zeros on it
+        [[nodiscard]] T operator()(std::size_t row, std::size_t column) const
+        {
+            assert(row < m_rows && column < m_columns);
+            if (m_layout == MatrixLayout::Full)
+                return m_values[row * m_columns + column];
+
+            if (row == column)
+                return T{};
+            if (row > column)
+                std::swap(row, column);
+            return m_values[matrixRowOffset(row, m_columns, m_layout) + column - row - 1];
+        }
+
+        [[nodiscard]] std::size_t rows() const { return m_rows; }
+        [[nodiscard]] std::size_t columns() const { return m_columns; }
+        [[nodiscard]] MatrixLayout layout() const { return m_layout; }
+
+        [[nodiscard]] std::span<T> values() { return m_values; }
+        [[nodiscard]] std::span<const T> values() const { return m_values; }
+
+        [[nodiscard]] std::size_t memoryUsage() const { return m_values.size() * sizeof(T); }
+    private:
+        std::size_t m_rows{ 0 };
+        std::size_t m_columns{ 0 };
+        MatrixLayout m_layout{ MatrixLayout::Full };
+        std::vector<T> m_values;
+    };
+
+    /**
+     * Receives the matrix in consecutive bands of whole rows, values holds the stored entries
+     * of rows [firstRow, firstRow + rowCount) in the layout of the options
+     */
+    template <typename T>
+    using MatrixSink = std::function<void(std::size_t firstRow, std::size_t rowCount, std::span<const T> values)>;
+
+    /**
+     * @return Sink that writes the values as raw T in native byte order, the stream must outlive it.
+     *         A failed write throws std::runtime_error from the Matrix function streaming into the sink
+     */
+    template <typename T>
+    MatrixSink<T> binaryMatrixSink(std::ostream& out);
+
+    // T is double or float, distances are always computed in double precision
+    namespace Matrix
+    {
+        template <typename T = double>
+        DistanceMatrix<T> distance2DCartesian(const CartesianArray2D<double>& rows, const CartesianArray2D<double>& columns,
+                                              const MatrixOptions& options = {});
+
+        template <typename T = double>
+        DistanceMatrix<T> distance3DCartesian(const CartesianArray3D<double>& rows, const CartesianArray3D<double>& columns,
+                                              const MatrixOptions& options = {});
+
+        template <typename T = double>
+        DistanceMatrix<T> distance3DSpherical(const SphericalArray<double>& rows, const SphericalArray<double>& columns,
+                                              SphericalMetric metric, const MatrixOptions& options = {});
+
+        template <typename T = double>
+        void distance2DCartesian(const CartesianArray2D<double>& rows, const CartesianArray2D<double>& columns,
+                                 const MatrixSink<T>& sink, const MatrixOptions& options = {});
+
+        template <typename T = double>
+        void distance3DCartesian(const CartesianArray3D<double>& rows, const CartesianArray3D<double>& columns,
+                                 const MatrixSink<T>& sink, const MatrixOptions& options = {});
+
+        template <typename T = double>
+        void distance3DSpherical(const SphericalArray<double>& rows, const SphericalArray<double>& columns,
+                                 SphericalMetric metric, const MatrixSink<T>& sink, const MatrixOptions& options = {});
+    }
+}
+
+#endif //COORDSYSTEM_DISTANCEMATRIX_H
@@ -0,0 +1,85 @@
+#include "Generators.h"
+
+#include <cassert>
+
+#include "Coordinates/ParallelChunks.h"
+
+namespace Coord::Generate
+{
+    namespace
+    {
+        // Value j of a stream is half j % 2 of block j / 2, so a block is computed once for two values
+        template <typename T>
+        void fillUniform(const std::span<T> out, const RandomRange range, const Philox4x32& philox,
+                         const std::uint64_t stream, const std::size_t first)
+        {
+            const double scale { range.max - range.min };
+            const auto value = [&](const Philox4x32::Block& block, const std::size_t half)
+            {
+                return static_cast<T>(range.min + scale * toUnitInterval(block[2 * half], block[2 * half + 1]));
+            };
+
+            std::size_t i { 0 };
+            if (first % 2 && !out.empty())
+                out[i++] = value(philox(first / 2, stream), 1);
+
+            for (; i + 1 < out.size(); i += 2)
+            {
+                const Philox4x32::Block block { philox((first + i) / 2, stream) };
+                out[i] = value(block, 0);
+                out[i + 1] = value(block, 1);
+            }
+
+            if (i < out.size())
+                out[i] = value(philox((first + i) / 2, stream), 0);
+        }
+    }
+
+    template <typename T>
+    void uniform(std::span<T> out, const RandomRange range, const std::uint64_t seed, const std::uint64_t stream,
+                 const std::size_t first, const ParallelOptions& options)
+    {
+        const Philox4x32 philox { seed };
+        Detail::forEachChunk<T>(out.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            fillUniform(out.subspan(offset, count), range, philox, stream, first + offset);
+        });
+    }
+
+    template <typename T>
+    void polar(PolarSpan<T> points, const std::uint64_t seed, const PolarDistribution& distribution,
+               const std::size_t first, const ParallelOptions& options)
+    {
+        assert(points.theta.size() == points.radius.size());
+        const Philox4x32 philox { seed };
+        Detail::forEachChunk<T>(points.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            fillUniform(points.radius.subspan(offset, count), distribution.radius, philox, 0, first + offset);
+            fillUniform(points.theta.subspan(offset, count), distribution.theta, philox, 1, first + offset);
+        });
+    }
+
+    template <typename T>
+    void spherical(SphericalSpan<T> points, const std::uint64_t seed, const SphericalDistribution& distribution,
+                   const std::size_t first, const ParallelOptions& options)
+    {
+        assert(points.theta.size() == points.radius.size() && points.polarAngle.size() == points.radius.size());
+        const Philox4x32 philox { seed };
+        Detail::forEachChunk<T>(points.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            fillUniform(points.radius.subspan(offset, count), distribution.radius, philox, 0, first + offset);
+            fillUniform(points.theta.subspan(offset, count), distribution.theta, philox, 1, first + offset);
+            fillUniform(points.polarAngle.subspan(offset, count), distribution.polarAngle, philox, 2, first + offset);
+        });
+    }
+
+#define COORD_INSTANTIATE_GENERATORS(T) \
+    template void uniform<T>(std::span<T>, RandomRange, std::uint64_t, std::uint64_t, std::size_t, const ParallelOptions&); \
+    template void polar<T>(PolarSpan<T>, std::uint64_t, const PolarDistribution&, std::size_t, const ParallelOptions&); \
+    template void spherical<T>(SphericalSpan<T>, std::uint64_t, const SphericalDistribution&, std::size_t, const ParallelOptions&);
+
+    COORD_INSTANTIATE_GENERATORS(double)
+    COORD_INSTANTIATE_GENERATORS(float)
+
+#undef COORD_INSTANTIATE_GENERATORS
+}
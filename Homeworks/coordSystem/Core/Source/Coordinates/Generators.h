@@ -0,0 +1,123 @@
+#ifndef COORDSYSTEM_GENERATORS_H
+#define COORDSYSTEM_GENERATORS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Coordinates/ParallelConversions.h"
+#include "Coordinates/PointArrays.h"
+#include "Coordinates/Simd/SimdMath.h"
+
+// Random point sets for tests and benchmarks. Every value is a pure function of (seed, stream, index),
+// so the columns are filled in parallel and come out identical for a seed no matter how many threads
+// took part or how the work was split. Any index range can be generated on its own, e.g. to produce
+// one shard of a huge set per machine.
+namespace Coord
+{
+    /**
+     * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+     * Ten rounds of multiply and xor turn a 128-bit counter and 64-bit key into four random words,
+     * there is no state to carry from one number to the next.
+     */
+    class Philox4x32
+    {
+    public:
+        using Block = std::array<std::uint32_t, 4>;
+
+        constexpr explicit Philox4x32(const std::uint64_t seed)
+            : m_key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) } {}
+
+        [[nodiscard]] constexpr Block operator()(const std::uint64_t counter, const std::uint64_t stream) const
+        {
+            Block block { static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+                          static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) };
+            std::uint32_t key0 { m_key[0] }, key1 { m_key[1] };
+
+            for (int round = 0; round < 10; ++round)
+            {
+                const std::uint64_t product0 { std::uint64_t{ kMultiplier0 } * block[0] };
+                const std::uint64_t product1 { std::uint64_t{ kMultiplier1 } * block[2] };
+                block = { static_cast<std::uint32_t>(product1 >> 32) ^ block[1] ^ key0, static_cast<std::uint32_t>(product1),
+                          static_cast<std::uint32_t>(product0 >> 32) ^ block[3] ^ key1, static_cast<std::uint32_t>(product0) };
+                key0 += kWeyl0;
+                key1 += kWeyl1;
+            }
+            return block;
+        }
+    private:
+        static constexpr std::uint32_t kMultiplier0 { 0xD2511F53 };
+        static constexpr std::uint32_t kMultiplier1 { 0xCD9E8D57 };
+        static constexpr std::uint32_t kWeyl0 { 0x9E3779B9 };
+        static constexpr std::uint32_t kWeyl1 { 0xBB67AE85 };
+
+        std::array<std::uint32_t, 2> m_key;
+    };
+
+    // Known answers of Philox4x32-10 from the Random123 distribution. The counter fills words 0 and 1
+    // of the block, the stream words 2 and 3, and the seed is key word 0 in its low and 1 in its high half
+    static_assert(Philox4x32{ 0 }(0, 0) == Philox4x32::Block{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+    static_assert(Philox4x32{ 0xffffffffffffffff }(0xffffffffffffffff, 0xffffffffffffffff)
+                  == Philox4x32::Block{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+    static_assert(Philox4x32{ 0x299f31d0a4093822 }(0x85a308d3243f6a88, 0x0370734413198a2e)
+                  == Philox4x32::Block{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+
+    /**
+     * @return Uniform double in [0, 1) from the top 53 of the 64 bits in hi:lo
+     */
+    constexpr double toUnitInterval(const std::uint32_t hi, const std::uint32_t lo)
+    {
+        // Signed, 53 bits fit and x86 converts signed integers in one instruction
+        const std::int64_t bits { static_cast<std::int64_t>((std::uint64_t{ hi } << 32 | lo) >> 11) };
+        return static_cast<double>(bits) * 0x1.0p-53;
+    }
+
+    struct RandomRange
+    {
+        double min{ 0.0 };
+        double max{ 1.0 };
+    };
+
+    // By default radius in [0, 100] and the angles over their full range: theta in [-pi, pi]
+    // and the polar angle in [0, pi]. Pass other ranges for e.g. LB1's old [0, 100] for every coordinate
+    struct PolarDistribution
+    {
+        RandomRange radius{ 0.0, 100.0 };
+        RandomRange theta{ -Simd::kPi, Simd::kPi };
+    };
+
+    struct SphericalDistribution
+    {
+        RandomRange radius{ 0.0, 100.0 };
+        RandomRange theta{ -Simd::kPi, Simd::kPi };
+        RandomRange polarAngle{ 0.0, Simd::kPi };
+    };
+
+    namespace Generate
+    {
+        /**
+         * out[i] = uniform value of index first + i in stream of seed. Streams of one seed, and different seeds,
+         * are independent of each other.
+         */
+        template <typename T>
+        void uniform(std::span<T> out, RandomRange range, std::uint64_t seed, std::uint64_t stream,
+                     std::size_t first = 0, const ParallelOptions& options = {});
+
+        /**
+         * Fills every point of the preallocated columns, stream 0 and 1 of seed for radius and theta
+         */
+        template <typename T>
+        void polar(PolarSpan<T> points, std::uint64_t seed, const PolarDistribution& distribution = {},
+                   std::size_t first = 0, const ParallelOptions& options = {});
+
+        /**
+         * Fills every point of the preallocated columns, stream 0, 1 and 2 of seed for radius, theta and polar angle
+         */
+        template <typename T>
+        void spherical(SphericalSpan<T> points, std::uint64_t seed, const SphericalDistribution& distribution = {},
+                       std::size_t first = 0, const ParallelOptions& options = {});
+    }
+}
+
+#endif //COORDSYSTEM_GENERATORS_H
@@ -0,0 +1,142 @@
+#ifndef COORDSYSTEM_MATHACCURACY_H
+#define COORDSYSTEM_MATHACCURACY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include "Coordinates/MathPolicy.h"
+
+// Measures how far a math policy is from libm and checks it against the bounds documented in MathPolicy.h.
+// coordSystemBenchmarks runs the check and fails when a policy exceeds its bounds.
+namespace Coord
+{
+    struct ErrorStats
+    {
+        double maxUlp{ 0.0 };
+        double meanUlp{ 0.0 };
+        double maxAbs{ 0.0 };
+        double meanAbs{ 0.0 };
+    };
+
+    struct PolicyAccuracy
+    {
+        ErrorStats sin, cos, atan2, acos;
+        // Simd::sin on Math::Vec, the sin without cos of the haversine kernels. Not measured for ExactMath
+        ErrorStats simdSin;
+    };
+
+    // Max errors a policy may have, infinity where a function isn't bound that way
+    struct AccuracyBounds
+    {
+        // In ULP of the policy's Real
+        double sinCosUlp{ std::numeric_limits<double>::infinity() };
+        double atan2Ulp{ std::numeric_limits<double>::infinity() };
+        double acosUlp{ std::numeric_limits<double>::infinity() };
+        // Absolute, for sin/cos computed in float where relative error grows near the zeros
+        double sinCosAbs{ std::numeric_limits<double>::infinity() };
+        // Simd::sin in the policy's Real, documented in SimdMath.h
+        double simdSinUlp{ std::numeric_limits<double>::infinity() };
+        double simdSinAbs{ std::numeric_limits<double>::infinity() };
+    };
+
+    // The bounds MathPolicy.h documents for Math, only defined for the approximating policies
+    template <typename Math>
+    constexpr AccuracyBounds documentedBounds();
+
+    template <>
+    constexpr AccuracyBounds documentedBounds<FastMath>()
+    {
+        return { .sinCosUlp = 2.0, .atan2Ulp = 3.0, .acosUlp = 3.0, .simdSinUlp = 3.0 };
+    }
+
+    template <>
+    constexpr AccuracyBounds documentedBounds<FastFloat32Math>()
+    {
+        return { .atan2Ulp = 3.0, .acosUlp = 4.0, .sinCosAbs = 1e-7, .simdSinAbs = 2e-7 };
+    }
+
+    [[nodiscard]] inline bool withinBounds(const PolicyAccuracy& accuracy, const AccuracyBounds& bounds)
+    {
+        const auto within = [](const ErrorStats& stats, const double maxUlp, const double maxAbs)
+        {
+            // Written so NaN errors fail
+            return stats.maxUlp <= maxUlp && stats.maxAbs <= maxAbs;
+        };
+
+        constexpr double kUnbounded { std::numeric_limits<double>::infinity() };
+        return within(accuracy.sin, bounds.sinCosUlp, bounds.sinCosAbs)
+            && within(accuracy.cos, bounds.sinCosUlp, bounds.sinCosAbs)
+            && within(accuracy.atan2, bounds.atan2Ulp, kUnbounded)
+            && within(accuracy.acos, bounds.acosUlp, kUnbounded)
+            && within(accuracy.simdSin, bounds.simdSinUlp, bounds.simdSinAbs);
+    }
+
+    /**
+     * @return Error of value in units in the last place of reference, in the precision of Real
+     */
+    template <typename Real>
+    double ulpError(const Real value, const Real reference)
+    {
+        if (value == reference)
+            return 0.0;
+
+        const Real magnitude { std::abs(reference) };
+        const Real ulp { std::max(std::nextafter(magnitude, std::numeric_limits<Real>::infinity()) - magnitude,
+                                  std::numeric_limits<Real>::denorm_min()) };
+        return std::abs(static_cast<double>(value) - static_cast<double>(reference)) / static_cast<double>(ulp);
+    }
+
+    /**
+     * @param samples Random arguments per function: |x| <= 1000 for sin/cos/atan2, [-1, 1] for acos
+     * @param seed Seed of the argument generator, so runs are comparable
+     */
+    template <typename Math>
+    PolicyAccuracy measureAccuracy(const std::size_t samples = 100000, const std::uint32_t seed = 42)
+    {
+        using Real = typename Math::Real;
+
+        std::mt19937 mt{ seed };
+        std::uniform_real_distribution<double> angle{ -1000.0, 1000.0 };
+        std::uniform_real_distribution<double> unit{ -1.0, 1.0 };
+
+        PolicyAccuracy accuracy;
+        auto record = [](ErrorStats& stats, const Real value, const double reference)
+        {
+            const Real rounded { static_cast<Real>(reference) };
+            stats.maxUlp = std::max(stats.maxUlp, ulpError(value, rounded));
+            stats.meanUlp += ulpError(value, rounded);
+            stats.maxAbs = std::max(stats.maxAbs, std::abs(static_cast<double>(value) - reference));
+            stats.meanAbs += std::abs(static_cast<double>(value) - reference);
+        };
+
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            const Real x { static_cast<Real>(angle(mt)) };
+            const Real y { static_cast<Real>(angle(mt)) };
+            const Real c { static_cast<Real>(unit(mt)) };
+
+            record(accuracy.sin, Math::sin(x), std::sin(static_cast<double>(x)));
+            record(accuracy.cos, Math::cos(x), std::cos(static_cast<double>(x)));
+            record(accuracy.atan2, Math::atan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x)));
+            record(accuracy.acos, Math::acos(c), std::acos(static_cast<double>(c)));
+            if constexpr (requires { typename Math::Vec; })
+                record(accuracy.simdSin, Simd::sin(typename Math::Vec{ x }).v, std::sin(static_cast<double>(x)));
+        }
+
+        if (samples > 0)
+        {
+            for (ErrorStats* stats : { &accuracy.sin, &accuracy.cos, &accuracy.atan2, &accuracy.acos, &accuracy.simdSin })
+            {
+                stats->meanUlp /= static_cast<double>(samples);
+                stats->meanAbs /= static_cast<double>(samples);
+            }
+        }
+
+        return accuracy;
+    }
+}
+
+#endif //COORDSYSTEM_MATHACCURACY_H
@@ -0,0 +1,79 @@
+#ifndef COORDSYSTEM_MATHPOLICY_H
+#define COORDSYSTEM_MATHPOLICY_H
+
+#include <cmath>
+
+#include "Coordinates/Simd/ScalarVec.h"
+#include "Coordinates/Simd/SimdMath.h"
+
+// Math policies for the coordinate conversions and distance functions.
+// Pass one as the first template argument, e.g. PolarPoint::fromCartesian<Coord::FastMath>(c).
+//
+// Every policy computes in Policy::Real and provides sqrt, sin, cos, sinCos, atan2 and acos.
+// Error bounds below are against libm in the same precision, measured over |x| <= 1000
+// (see Coordinates/MathAccuracy.h, checked on every run of coordSystemBenchmarks).
+namespace Coord
+{
+    // libm, what the conversions always used. constexpr where <cmath> is, so conversions work in constant tables
+    struct ExactMath
+    {
+        using Real = double;
+
+        static constexpr Real sqrt(Real x) { return std::sqrt(x); }
+        static constexpr Real sin(Real x) { return std::sin(x); }
+        static constexpr Real cos(Real x) { return std::cos(x); }
+        static constexpr void sinCos(Real x, Real& s, Real& c) { s = std::sin(x); c = std::cos(x); }
+        static constexpr Real atan2(Real y, Real x) { return std::atan2(y, x); }
+        static constexpr Real acos(Real x) { return std::acos(x); }
+    };
+
+    /**
+     * Double precision Cephes polynomials, same code as the SIMD batch kernels.
+     * Max error: sin/cos 2 ULP, atan2 3 ULP, acos 3 ULP (mean ~0.3 ULP).
+     * Finite input only, atan2 of two infinities returns NaN.
+     */
+    struct FastMath
+    {
+        using Real = double;
+        using Vec = Simd::ScalarVec<Real>;
+
+        static Real sqrt(Real x) { return std::sqrt(x); }
+        static Real sin(Real x) { Real s, c; sinCos(x, s, c); return s; }
+        static Real cos(Real x) { Real s, c; sinCos(x, s, c); return c; }
+        static void sinCos(Real x, Real& s, Real& c)
+        {
+            Vec vs, vc;
+            Simd::sinCos(Vec{ x }, vs, vc);
+            s = vs.v;
+            c = vc.v;
+        }
+        static Real atan2(Real y, Real x) { return Simd::atan2(Vec{ y }, Vec{ x }).v; }
+        static Real acos(Real x) { return Simd::acos(Vec{ x }).v; }
+    };
+
+    /**
+     * Single precision Cephes polynomials, for display and tracking where float precision is enough.
+     * Max error: sin/cos 1e-7 absolute (range reduction in float, so relative error grows near
+     * the zeros), atan2 3 float ULP, acos 4 float ULP.
+     */
+    struct FastFloat32Math
+    {
+        using Real = float;
+        using Vec = Simd::ScalarVec<Real>;
+
+        static Real sqrt(Real x) { return std::sqrt(x); }
+        static Real sin(Real x) { Real s, c; sinCos(x, s, c); return s; }
+        static Real cos(Real x) { Real s, c; sinCos(x, s, c); return c; }
+        static void sinCos(Real x, Real& s, Real& c)
+        {
+            Vec vs, vc;
+            Simd::sinCos(Vec{ x }, vs, vc);
+            s = vs.v;
+            c = vc.v;
+        }
+        static Real atan2(Real y, Real x) { return Simd::atan2(Vec{ y }, Vec{ x }).v; }
+        static Real acos(Real x) { return Simd::acos(Vec{ x }).v; }
+    };
+}
+
+#endif //COORDSYSTEM_MATHPOLICY_H
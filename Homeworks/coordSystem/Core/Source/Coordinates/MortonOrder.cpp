@@ -0,0 +1,198 @@
+#include "MortonOrder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Coord::Morton
+{
+    namespace
+    {
+        // Maps one axis of the bounding box onto [0, 2^bits - 1]
+        struct AxisQuantizer
+        {
+            double min{ 0.0 };
+            double scale{ 0.0 };
+            double maxCell{ 0.0 };
+
+            [[nodiscard]] std::uint32_t operator()(const double value) const
+            {
+                const double cell { (value - min) * scale };
+                // Written so NaN goes to 0
+                if (!(cell > 0.0))
+                    return 0;
+                return static_cast<std::uint32_t>(cell < maxCell ? cell : maxCell);
+            }
+        };
+
+        // Quantizers over the bounding box of the finite coordinates, coordinate(i, axis) reads point i
+        template <std::size_t Dimensions, typename Coordinate>
+        std::array<AxisQuantizer, Dimensions> makeQuantizers(const std::size_t count, const unsigned bits, Coordinate coordinate)
+        {
+            std::array<double, Dimensions> min, max;
+            min.fill(std::numeric_limits<double>::infinity());
+            max.fill(-std::numeric_limits<double>::infinity());
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (std::size_t axis = 0; axis < Dimensions; ++axis)
+                {
+                    const double value { static_cast<double>(coordinate(i, axis)) };
+                    if (std::isfinite(value))
+                    {
+                        min[axis] = std::min(min[axis], value);
+                        max[axis] = std::max(max[axis], value);
+                    }
+                }
+            }
+
+            const double maxCell { std::ldexp(1.0, static_cast<int>(bits)) - 1.0 };
+            std::array<AxisQuantizer, Dimensions> quantizers;
+            for (std::size_t axis = 0; axis < Dimensions; ++axis)
+            {
+                // A flat axis, or no finite coordinate at all, puts every point in cell 0
+                const double extent { max[axis] - min[axis] };
+                quantizers[axis] = extent > 0.0 && std::isfinite(extent)
+                    ? AxisQuantizer{ min[axis], maxCell / extent, maxCell }
+                    : AxisQuantizer{ std::isfinite(min[axis]) ? min[axis] : 0.0, 0.0, maxCell };
+            }
+            return quantizers;
+        }
+
+        template <typename Coordinate>
+        void codes2D(const std::size_t count, const std::span<std::uint64_t> out, Coordinate coordinate)
+        {
+            assert(out.size() == count);
+            const auto quantizers { makeQuantizers<2>(count, kBits2D, coordinate) };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = encode2D(quantizers[0](coordinate(i, 0)), quantizers[1](coordinate(i, 1)));
+        }
+
+        template <typename Coordinate>
+        void codes3D(const std::size_t count, const std::span<std::uint64_t> out, Coordinate coordinate)
+        {
+            assert(out.size() == count);
+            const auto quantizers { makeQuantizers<3>(count, kBits3D, coordinate) };
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = encode3D(quantizers[0](coordinate(i, 0)), quantizers[1](coordinate(i, 1)), quantizers[2](coordinate(i, 2)));
+        }
+    }
+
+    template <typename T>
+    void codes(Cartesian2DSpan<const T> points, std::span<std::uint64_t> out)
+    {
+        assert(points.y.size() == points.size());
+        codes2D(points.size(), out, [&points](const std::size_t i, const std::size_t axis)
+        {
+            return axis == 0 ? points.x[i] : points.y[i];
+        });
+    }
+
+    template <typename T>
+    void codes(Cartesian3DSpan<const T> points, std::span<std::uint64_t> out)
+    {
+        assert(points.y.size() == points.size() && points.z.size() == points.size());
+        codes3D(points.size(), out, [&points](const std::size_t i, const std::size_t axis)
+        {
+            return axis == 0 ? points.x[i] : axis == 1 ? points.y[i] : points.z[i];
+        });
+    }
+
+    std::vector<std::size_t> sortPermutation(std::span<const std::uint64_t> keys)
+    {
+        constexpr std::size_t kPasses { sizeof(std::uint64_t) };
+        constexpr std::size_t kBuckets { 256 };
+        const std::size_t count { keys.size() };
+
+        // Key and index move together, one scattered write per item and pass
+        struct Item
+        {
+            std::uint64_t key;
+            std::size_t index;
+        };
+
+        // The counts of every pass in one read of the keys
+        std::vector<std::array<std::size_t, kBuckets>> histograms(kPasses);
+        for (const std::uint64_t key : keys)
+        {
+            for (std::size_t pass = 0; pass < kPasses; ++pass)
+                ++histograms[pass][key >> (8 * pass) & 0xFF];
+        }
+
+        std::vector<Item> items(count), scratch(count);
+        for (std::size_t i = 0; i < count; ++i)
+            items[i] = { keys[i], i };
+
+        for (std::size_t pass = 0; pass < kPasses && count > 0; ++pass)
+        {
+            const unsigned shift { static_cast<unsigned>(8 * pass) };
+            std::array<std::size_t, kBuckets>& histogram { histograms[pass] };
+            // Every key has the same byte here, the pass wouldn't move anything
+            if (histogram[keys[0] >> shift & 0xFF] == count)
+                continue;
+
+            std::exclusive_scan(histogram.begin(), histogram.end(), histogram.begin(), std::size_t{ 0 });
+            for (const Item& item : items)
+                scratch[histogram[item.key >> shift & 0xFF]++] = item;
+            items.swap(scratch);
+        }
+
+        std::vector<std::size_t> permutation(count);
+        for (std::size_t i = 0; i < count; ++i)
+            permutation[i] = items[i].index;
+        return permutation;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> order(Cartesian2DSpan<const T> points)
+    {
+        std::vector<std::uint64_t> keys(points.size());
+        codes<T>(points, keys);
+        return sortPermutation(keys);
+    }
+
+    template <typename T>
+    std::vector<std::size_t> order(Cartesian3DSpan<const T> points)
+    {
+        std::vector<std::uint64_t> keys(points.size());
+        codes<T>(points, keys);
+        return sortPermutation(keys);
+    }
+
+    template <typename T>
+    std::vector<std::size_t> order(std::span<const CartesianPoint2D<T>> points)
+    {
+        std::vector<std::uint64_t> keys(points.size());
+        codes2D(points.size(), keys, [&points](const std::size_t i, const std::size_t axis)
+        {
+            return axis == 0 ? points[i].x : points[i].y;
+        });
+        return sortPermutation(keys);
+    }
+
+    template <typename T>
+    std::vector<std::size_t> order(std::span<const CartesianPoint3D<T>> points)
+    {
+        std::vector<std::uint64_t> keys(points.size());
+        codes3D(points.size(), keys, [&points](const std::size_t i, const std::size_t axis)
+        {
+            return axis == 0 ? points[i].x : axis == 1 ? points[i].y : points[i].z;
+        });
+        return sortPermutation(keys);
+    }
+
+#define COORD_INSTANTIATE_MORTON(T) \
+    template void codes<T>(Cartesian2DSpan<const T>, std::span<std::uint64_t>); \
+    template void codes<T>(Cartesian3DSpan<const T>, std::span<std::uint64_t>); \
+    template std::vector<std::size_t> order<T>(Cartesian2DSpan<const T>); \
+    template std::vector<std::size_t> order<T>(Cartesian3DSpan<const T>); \
+    template std::vector<std::size_t> order<T>(std::span<const CartesianPoint2D<T>>); \
+    template std::vector<std::size_t> order<T>(std::span<const CartesianPoint3D<T>>);
+
+    COORD_INSTANTIATE_MORTON(double)
+    COORD_INSTANTIATE_MORTON(float)
+
+#undef COORD_INSTANTIATE_MORTON
+}
@@ -0,0 +1,195 @@
+#ifndef COORDSYSTEM_MORTONORDER_H
+#define COORDSYSTEM_MORTONORDER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/PointArrays.h"
+
+// Reordering of point sets along the Morton (Z-order) curve. Points close to each other in space end up
+// close to each other in memory, so neighbour queries, distance matrices and drawing over the reordered
+// set touch far fewer cache lines than over points in arrival order.
+//
+// The coordinates are quantized over the bounding box of the set and their bits interleaved into one
+// 64-bit code, 32 bits per axis in 2D and 21 in 3D. The codes are sorted with a stable LSD radix sort,
+// so points with the same code keep their order. The result is a permutation that reorders the point
+// columns and any attribute column attached to the points the same way.
+namespace Coord::Morton
+{
+    namespace Detail
+    {
+        // Spreads the 32 bits of v to the even bits of the result
+        constexpr std::uint64_t spreadBits2(std::uint64_t v)
+        {
+            v = (v | v << 16) & 0x0000FFFF0000FFFF;
+            v = (v | v << 8) & 0x00FF00FF00FF00FF;
+            v = (v | v << 4) & 0x0F0F0F0F0F0F0F0F;
+            v = (v | v << 2) & 0x3333333333333333;
+            v = (v | v << 1) & 0x5555555555555555;
+            return v;
+        }
+
+        constexpr std::uint32_t compactBits2(std::uint64_t v)
+        {
+            v &= 0x5555555555555555;
+            v = (v | v >> 1) & 0x3333333333333333;
+            v = (v | v >> 2) & 0x0F0F0F0F0F0F0F0F;
+            v = (v | v >> 4) & 0x00FF00FF00FF00FF;
+            v = (v | v >> 8) & 0x0000FFFF0000FFFF;
+            v = (v | v >> 16) & 0x00000000FFFFFFFF;
+            return static_cast<std::uint32_t>(v);
+        }
+
+        // Spreads the low 21 bits of v to every third bit of the result
+        constexpr std::uint64_t spreadBits3(std::uint64_t v)
+        {
+            v &= 0x1FFFFF;
+            v = (v | v << 32) & 0x001F00000000FFFF;
+            v = (v | v << 16) & 0x001F0000FF0000FF;
+            v = (v | v << 8) & 0x100F00F00F00F00F;
+            v = (v | v << 4) & 0x10C30C30C30C30C3;
+            v = (v | v << 2) & 0x1249249249249249;
+            return v;
+        }
+
+        constexpr std::uint32_t compactBits3(std::uint64_t v)
+        {
+            v &= 0x1249249249249249;
+            v = (v | v >> 2) & 0x10C30C30C30C30C3;
+            v = (v | v >> 4) & 0x100F00F00F00F00F;
+            v = (v | v >> 8) & 0x001F0000FF0000FF;
+            v = (v | v >> 16) & 0x001F00000000FFFF;
+            v = (v | v >> 32) & 0x00000000001FFFFF;
+            return static_cast<std::uint32_t>(v);
+        }
+    }
+
+    // Bits per axis of the quantized coordinates
+    constexpr unsigned kBits2D { 32 };
+    constexpr unsigned kBits3D { 21 };
+
+    // x goes to the lowest bit, so the curve runs along x first
+    constexpr std::uint64_t encode2D(const std::uint32_t x, const std::uint32_t y)
+    {
+        return Detail::spreadBits2(x) | Detail::spreadBits2(y) << 1;
+    }
+
+    // Only the low kBits3D bits of every coordinate are used
+    constexpr std::uint64_t encode3D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t z)
+    {
+        return Detail::spreadBits3(x) | Detail::spreadBits3(y) << 1 | Detail::spreadBits3(z) << 2;
+    }
+
+    constexpr void decode2D(const std::uint64_t code, std::uint32_t& x, std::uint32_t& y)
+    {
+        x = Detail::compactBits2(code);
+        y = Detail::compactBits2(code >> 1);
+    }
+
+    constexpr void decode3D(const std::uint64_t code, std::uint32_t& x, std::uint32_t& y, std::uint32_t& z)
+    {
+        x = Detail::compactBits3(code);
+        y = Detail::compactBits3(code >> 1);
+        z = Detail::compactBits3(code >> 2);
+    }
+
+    /**
+     * Morton code of every point, quantized over the bounding box of the set. Non-finite coordinates
+     * are clamped into the box (NaN to its lower corner).
+     */
+    template <typename T>
+    void codes(Cartesian2DSpan<const T> points, std::span<std::uint64_t> out);
+
+    template <typename T>
+    void codes(Cartesian3DSpan<const T> points, std::span<std::uint64_t> out);
+
+    /**
+     * Stable LSD radix sort of keys, 8 bits per pass. Passes over a byte every key has in common are skipped.
+     *
+     * @return permutation[i] = index of the key that sorts to position i
+     */
+    [[nodiscard]] std::vector<std::size_t> sortPermutation(std::span<const std::uint64_t> keys);
+
+    /**
+     * @return permutation[i] = index of the point at position i along the Morton curve
+     */
+    template <typename T>
+    [[nodiscard]] std::vector<std::size_t> order(Cartesian2DSpan<const T> points);
+
+    template <typename T>
+    [[nodiscard]] std::vector<std::size_t> order(Cartesian3DSpan<const T> points);
+
+    // Array of structures, e.g. the points a KdTree or UniformGrid is built from
+
+    template <typename T>
+    [[nodiscard]] std::vector<std::size_t> order(std::span<const CartesianPoint2D<T>> points);
+
+    template <typename T>
+    [[nodiscard]] std::vector<std::size_t> order(std::span<const CartesianPoint3D<T>> points);
+
+    /**
+     * out[i] = in[permutation[i]], for point columns and anything attached to the points.
+     * out must not overlap in.
+     */
+    template <typename T>
+    void permute(std::span<const std::size_t> permutation, std::span<const T> in, std::span<T> out)
+    {
+        assert(permutation.size() == in.size() && out.size() == in.size());
+        for (std::size_t i = 0; i < permutation.size(); ++i)
+            out[i] = in[permutation[i]];
+    }
+
+    // In place, through a temporary copy of values
+    template <typename T>
+    void permute(std::span<const std::size_t> permutation, std::span<T> values)
+    {
+        const std::vector<T> copy(values.begin(), values.end());
+        permute<T>(permutation, copy, values);
+    }
+
+    /**
+     * Reorders the points along the Morton curve
+     *
+     * @return The permutation applied, pass it to permute() for the attributes of the points
+     */
+    template <typename T>
+    std::vector<std::size_t> sort(CartesianArray2D<T>& points)
+    {
+        std::vector<std::size_t> permutation { order<T>(points.view()) };
+        permute<T>(permutation, points.x());
+        permute<T>(permutation, points.y());
+        return permutation;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> sort(CartesianArray3D<T>& points)
+    {
+        std::vector<std::size_t> permutation { order<T>(points.view()) };
+        permute<T>(permutation, points.x());
+        permute<T>(permutation, points.y());
+        permute<T>(permutation, points.z());
+        return permutation;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> sort(std::vector<CartesianPoint2D<T>>& points)
+    {
+        std::vector<std::size_t> permutation { order<T>(std::span<const CartesianPoint2D<T>>{ points }) };
+        permute<CartesianPoint2D<T>>(permutation, points);
+        return permutation;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> sort(std::vector<CartesianPoint3D<T>>& points)
+    {
+        std::vector<std::size_t> permutation { order<T>(std::span<const CartesianPoint3D<T>>{ points }) };
+        permute<CartesianPoint3D<T>>(permutation, points);
+        return permutation;
+    }
+}
+
+#endif //COORDSYSTEM_MORTONORDER_H
@@ -0,0 +1,36 @@
+#ifndef COORDSYSTEM_PARALLELCHUNKS_H
+#define COORDSYSTEM_PARALLELCHUNKS_H
+
+#include <cstddef>
+
+#include "Core/CacheLine.h"
+#include "Core/ThreadPool.h"
+#include "Coordinates/ParallelConversions.h"
+
+// Splitting of columns over the thread pool, shared by the Parallel conversions and the generators
+namespace Coord::Detail
+{
+    // Chunks are a whole number of cache lines of T long. The columns themselves aren't aligned
+    // to cache lines, so neighbouring chunks share the one line across their border but no other
+    template <typename T>
+    constexpr std::size_t kChunkAlignment { Core::kCacheLineSize / sizeof(T) };
+
+    /**
+     * Calls kernel(offset, count) for contiguous chunks covering [0, count) of a column of T,
+     * each at least options.minChunk long except the last
+     */
+    template <typename T, typename Kernel>
+    void forEachChunk(const std::size_t count, const ParallelOptions& options, Kernel kernel)
+    {
+        Core::ThreadPool& pool { options.pool ? *options.pool : Core::ThreadPool::Get() };
+        constexpr std::size_t alignment { kChunkAlignment<T> };
+        const std::size_t grain { (options.minChunk + alignment - 1) / alignment * alignment };
+
+        pool.ParallelFor(count, grain, [&kernel](const std::size_t begin, const std::size_t end)
+        {
+            kernel(begin, end - begin);
+        }, options.maxThreads);
+    }
+}
+
+#endif //COORDSYSTEM_PARALLELCHUNKS_H
@@ -0,0 +1,59 @@
+#include "ParallelConversions.h"
+
+#include <cassert>
+
+#include "Coordinates/BatchConversions.h"
+#include "Coordinates/ParallelChunks.h"
+
+namespace Coord::Parallel
+{
+    void polarToCartesian(std::span<const double> radius, std::span<const double> theta,
+                          std::span<double> x, std::span<double> y,
+                          const ParallelOptions& options)
+    {
+        assert(theta.size() == radius.size() && x.size() == radius.size() && y.size() == radius.size());
+        Detail::forEachChunk<double>(radius.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            Batch::polarToCartesian(radius.subspan(offset, count), theta.subspan(offset, count),
+                                    x.subspan(offset, count), y.subspan(offset, count));
+        });
+    }
+
+    void cartesianToPolar(std::span<const double> x, std::span<const double> y,
+                          std::span<double> radius, std::span<double> theta,
+                          const ParallelOptions& options)
+    {
+        assert(y.size() == x.size() && radius.size() == x.size() && theta.size() == x.size());
+        Detail::forEachChunk<double>(x.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            Batch::cartesianToPolar(x.subspan(offset, count), y.subspan(offset, count),
+                                    radius.subspan(offset, count), theta.subspan(offset, count));
+        });
+    }
+
+    void sphericalToCartesian(std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                              std::span<double> x, std::span<double> y, std::span<double> z,
+                              const ParallelOptions& options)
+    {
+        assert(theta.size() == radius.size() && polarAngle.size() == radius.size());
+        assert(x.size() == radius.size() && y.size() == radius.size() && z.size() == radius.size());
+        Detail::forEachChunk<double>(radius.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            Batch::sphericalToCartesian(radius.subspan(offset, count), theta.subspan(offset, count), polarAngle.subspan(offset, count),
+                                        x.subspan(offset, count), y.subspan(offset, count), z.subspan(offset, count));
+        });
+    }
+
+    void cartesianToSpherical(std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                              std::span<double> radius, std::span<double> theta, std::span<double> polarAngle,
+                              const ParallelOptions& options)
+    {
+        assert(y.size() == x.size() && z.size() == x.size());
+        assert(radius.size() == x.size() && theta.size() == x.size() && polarAngle.size() == x.size());
+        Detail::forEachChunk<double>(x.size(), options, [&](const std::size_t offset, const std::size_t count)
+        {
+            Batch::cartesianToSpherical(x.subspan(offset, count), y.subspan(offset, count), z.subspan(offset, count),
+                                        radius.subspan(offset, count), theta.subspan(offset, count), polarAngle.subspan(offset, count));
+        });
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef COORDSYSTEM_PARALLELCONVERSIONS_H
+#define COORDSYSTEM_PARALLELCONVERSIONS_H
+
+#include <cstddef>
+#include <span>
+
+namespace Core
+{
+    class ThreadPool;
+}
+
+// Multithreaded versions of the Coord::Batch conversions. The columns are split into contiguous
+// chunks and every chunk runs the SIMD kernel on its own slice, so the output is identical to the
+// single-threaded call no matter how many threads took part.
+namespace Coord
+{
+    struct ParallelOptions
+    {
+        // nullptr uses Core::ThreadPool::Get()
+        Core::ThreadPool* pool{ nullptr };
+        // 0 uses every thread of the pool
+        std::size_t maxThreads{ 0 };
+        // Points per chunk at least. Smaller inputs aren't worth waking up other threads for
+        std::size_t minChunk{ 1 << 15 };
+    };
+
+    namespace Parallel
+    {
+        void polarToCartesian(std::span<const double> radius, std::span<const double> theta,
+                              std::span<double> x, std::span<double> y,
+                              const ParallelOptions& options = {});
+
+        void cartesianToPolar(std::span<const double> x, std::span<const double> y,
+                              std::span<double> radius, std::span<double> theta,
+                              const ParallelOptions& options = {});
+
+        void sphericalToCartesian(std::span<const double> radius, std::span<const double> theta, std::span<const double> polarAngle,
+                                  std::span<double> x, std::span<double> y, std::span<double> z,
+                                  const ParallelOptions& options = {});
+
+        void cartesianToSpherical(std::span<const double> x, std::span<const double> y, std::span<const double> z,
+                                  std::span<double> radius, std::span<double> theta, std::span<double> polarAngle,
+                                  const ParallelOptions& options = {});
+    }
+}
+
+#endif //COORDSYSTEM_PARALLELCONVERSIONS_H
@@ -0,0 +1,362 @@
+#ifndef COORDSYSTEM_POINTARRAYS_H
+#define COORDSYSTEM_POINTARRAYS_H
+
+#include <cassert>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/BatchConversions.h"
+
+// Structure-of-arrays containers for the point types from CoordinateSystems.h.
+// Every coordinate lives in its own contiguous column, so bulk loops touch only
+// the data they need and can be vectorized.
+namespace Coord
+{
+    /**
+     * Non-owning views over the columns of a point array.
+     * Use a const-qualified T for read-only views.
+     */
+    template <typename T>
+    struct PolarSpan
+    {
+        std::span<T> radius;
+        std::span<T> theta;
+
+        [[nodiscard]] std::size_t size() const { return radius.size(); }
+
+        operator PolarSpan<const T>() const requires(!std::is_const_v<T>) { return { radius, theta }; }
+    };
+
+    template <typename T>
+    struct Cartesian2DSpan
+    {
+        std::span<T> x;
+        std::span<T> y;
+
+        [[nodiscard]] std::size_t size() const { return x.size(); }
+
+        operator Cartesian2DSpan<const T>() const requires(!std::is_const_v<T>) { return { x, y }; }
+    };
+
+    template <typename T>
+    struct SphericalSpan
+    {
+        std::span<T> radius;
+        std::span<T> theta;
+        std::span<T> polarAngle;
+
+        [[nodiscard]] std::size_t size() const { return radius.size(); }
+
+        operator SphericalSpan<const T>() const requires(!std::is_const_v<T>) { return { radius, theta, polarAngle }; }
+    };
+
+    template <typename T>
+    struct Cartesian3DSpan
+    {
+        std::span<T> x;
+        std::span<T> y;
+        std::span<T> z;
+
+        [[nodiscard]] std::size_t size() const { return x.size(); }
+
+        operator Cartesian3DSpan<const T>() const requires(!std::is_const_v<T>) { return { x, y, z }; }
+    };
+
+    // Bulk conversions between views. The output must already have the size of the input.
+    // Double columns go through the SIMD kernels from BatchConversions.h, other types use
+    // the formulas of the point types.
+    template <typename T>
+    void polarToCartesian(std::type_identity_t<PolarSpan<const T>> in, Cartesian2DSpan<T> out)
+    {
+        assert(in.size() == out.size());
+        if constexpr (std::is_same_v<T, double>)
+        {
+            Batch::polarToCartesian(in.radius, in.theta, out.x, out.y);
+            return;
+        }
+
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            const auto c { CartesianPoint2D<T>::fromPolar(BasicPolarPoint<T>{ in.radius[i], in.theta[i] }) };
+            out.x[i] = c.getX();
+            out.y[i] = c.getY();
+        }
+    }
+
+    template <typename T>
+    void cartesianToPolar(std::type_identity_t<Cartesian2DSpan<const T>> in, PolarSpan<T> out)
+    {
+        assert(in.size() == out.size());
+        if constexpr (std::is_same_v<T, double>)
+        {
+            Batch::cartesianToPolar(in.x, in.y, out.radius, out.theta);
+            return;
+        }
+
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            const auto p { BasicPolarPoint<T>::fromCartesian(CartesianPoint2D<T>{ in.x[i], in.y[i] }) };
+            out.radius[i] = p.getRadius();
+            out.theta[i] = p.getTheta();
+        }
+    }
+
+    template <typename T>
+    void sphericalToCartesian(std::type_identity_t<SphericalSpan<const T>> in, Cartesian3DSpan<T> out)
+    {
+        assert(in.size() == out.size());
+        if constexpr (std::is_same_v<T, double>)
+        {
+            Batch::sphericalToCartesian(in.radius, in.theta, in.polarAngle, out.x, out.y, out.z);
+            return;
+        }
+
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            const auto c { CartesianPoint3D<T>::fromSpherical(BasicSphericalPoint<T>{ in.radius[i], in.theta[i], in.polarAngle[i] }) };
+            out.x[i] = c.getX();
+            out.y[i] = c.getY();
+            out.z[i] = c.getZ();
+        }
+    }
+
+    template <typename T>
+    void cartesianToSpherical(std::type_identity_t<Cartesian3DSpan<const T>> in, SphericalSpan<T> out)
+    {
+        assert(in.size() == out.size());
+        if constexpr (std::is_same_v<T, double>)
+        {
+            Batch::cartesianToSpherical(in.x, in.y, in.z, out.radius, out.theta, out.polarAngle);
+            return;
+        }
+
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            const auto s { BasicSphericalPoint<T>::fromCartesian(CartesianPoint3D<T>{ in.x[i], in.y[i], in.z[i] }) };
+            out.radius[i] = s.getRadius();
+            out.theta[i] = s.getTheta();
+            out.polarAngle[i] = s.getPolarAngle();
+        }
+    }
+
+    template <typename T = double>
+    class CartesianArray2D;
+
+    template <typename T = double>
+    class CartesianArray3D;
+
+    template <typename T = double>
+    class PolarArray
+    {
+    public:
+        PolarArray() = default;
+        explicit PolarArray(std::size_t size)
+            : m_radius(size), m_theta(size)
+        {}
+
+        static PolarArray fromCartesian(const CartesianArray2D<T>& c)
+        {
+            PolarArray p(c.size());
+            cartesianToPolar<T>(c.view(), p.view());
+            return p;
+        }
+
+        static PolarArray fromPoints(std::span<const BasicPolarPoint<T>> points)
+        {
+            PolarArray p;
+            p.reserve(points.size());
+            for (const BasicPolarPoint<T>& point : points)
+                p.push_back(point);
+            return p;
+        }
+
+        void push_back(const BasicPolarPoint<T>& p)
+        {
+            m_radius.push_back(p.getRadius());
+            m_theta.push_back(p.getTheta());
+        }
+
+        void resize(std::size_t size) { m_radius.resize(size); m_theta.resize(size); }
+        void reserve(std::size_t size) { m_radius.reserve(size); m_theta.reserve(size); }
+        void clear() { m_radius.clear(); m_theta.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_radius.size(); }
+        [[nodiscard]] bool empty() const { return m_radius.empty(); }
+
+        [[nodiscard]] BasicPolarPoint<T> operator[](std::size_t i) const { return { m_radius[i], m_theta[i] }; }
+
+        [[nodiscard]] std::span<T> radius() { return m_radius; }
+        [[nodiscard]] std::span<const T> radius() const { return m_radius; }
+        [[nodiscard]] std::span<T> theta() { return m_theta; }
+        [[nodiscard]] std::span<const T> theta() const { return m_theta; }
+
+        [[nodiscard]] PolarSpan<T> view() { return { m_radius, m_theta }; }
+        [[nodiscard]] PolarSpan<const T> view() const { return { m_radius, m_theta }; }
+    private:
+        std::vector<T> m_radius, m_theta;
+    };
+
+    template <typename T>
+    class CartesianArray2D
+    {
+    public:
+        CartesianArray2D() = default;
+        explicit CartesianArray2D(std::size_t size)
+            : m_x(size), m_y(size)
+        {}
+
+        static CartesianArray2D fromPolar(const PolarArray<T>& p)
+        {
+            CartesianArray2D c(p.size());
+            polarToCartesian<T>(p.view(), c.view());
+            return c;
+        }
+
+        static CartesianArray2D fromPoints(std::span<const CartesianPoint2D<T>> points)
+        {
+            CartesianArray2D c;
+            c.reserve(points.size());
+            for (const CartesianPoint2D<T>& point : points)
+                c.push_back(point);
+            return c;
+        }
+
+        void push_back(const CartesianPoint2D<T>& p)
+        {
+            m_x.push_back(p.getX());
+            m_y.push_back(p.getY());
+        }
+
+        void resize(std::size_t size) { m_x.resize(size); m_y.resize(size); }
+        void reserve(std::size_t size) { m_x.reserve(size); m_y.reserve(size); }
+        void clear() { m_x.clear(); m_y.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_x.size(); }
+        [[nodiscard]] bool empty() const { return m_x.empty(); }
+
+        [[nodiscard]] CartesianPoint2D<T> operator[](std::size_t i) const { return { m_x[i], m_y[i] }; }
+
+        [[nodiscard]] std::span<T> x() { return m_x; }
+        [[nodiscard]] std::span<const T> x() const { return m_x; }
+        [[nodiscard]] std::span<T> y() { return m_y; }
+        [[nodiscard]] std::span<const T> y() const { return m_y; }
+
+        [[nodiscard]] Cartesian2DSpan<T> view() { return { m_x, m_y }; }
+        [[nodiscard]] Cartesian2DSpan<const T> view() const { return { m_x, m_y }; }
+    private:
+        std::vector<T> m_x, m_y;
+    };
+
+    // Radius - радіус-вектор rho, theta - азимутальний кут, polarAngle - полярний кут phi
+    template <typename T = double>
+    class SphericalArray
+    {
+    public:
+        SphericalArray() = default;
+        explicit SphericalArray(std::size_t size)
+            : m_radius(size), m_theta(size), m_polarAngle(size)
+        {}
+
+        static SphericalArray fromCartesian(const CartesianArray3D<T>& c)
+        {
+            SphericalArray s(c.size());
+            cartesianToSpherical<T>(c.view(), s.view());
+            return s;
+        }
+
+        static SphericalArray fromPoints(std::span<const BasicSphericalPoint<T>> points)
+        {
+            SphericalArray s;
+            s.reserve(points.size());
+            for (const BasicSphericalPoint<T>& point : points)
+                s.push_back(point);
+            return s;
+        }
+
+        void push_back(const BasicSphericalPoint<T>& p)
+        {
+            m_radius.push_back(p.getRadius());
+            m_theta.push_back(p.getTheta());
+            m_polarAngle.push_back(p.getPolarAngle());
+        }
+
+        void resize(std::size_t size) { m_radius.resize(size); m_theta.resize(size); m_polarAngle.resize(size); }
+        void reserve(std::size_t size) { m_radius.reserve(size); m_theta.reserve(size); m_polarAngle.reserve(size); }
+        void clear() { m_radius.clear(); m_theta.clear(); m_polarAngle.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_radius.size(); }
+        [[nodiscard]] bool empty() const { return m_radius.empty(); }
+
+        [[nodiscard]] BasicSphericalPoint<T> operator[](std::size_t i) const { return { m_radius[i], m_theta[i], m_polarAngle[i] }; }
+
+        [[nodiscard]] std::span<T> radius() { return m_radius; }
+        [[nodiscard]] std::span<const T> radius() const { return m_radius; }
+        [[nodiscard]] std::span<T> theta() { return m_theta; }
+        [[nodiscard]] std::span<const T> theta() const { return m_theta; }
+        [[nodiscard]] std::span<T> polarAngle() { return m_polarAngle; }
+        [[nodiscard]] std::span<const T> polarAngle() const { return m_polarAngle; }
+
+        [[nodiscard]] SphericalSpan<T> view() { return { m_radius, m_theta, m_polarAngle }; }
+        [[nodiscard]] SphericalSpan<const T> view() const { return { m_radius, m_theta, m_polarAngle }; }
+    private:
+        std::vector<T> m_radius, m_theta, m_polarAngle;
+    };
+
+    template <typename T>
+    class CartesianArray3D
+    {
+    public:
+        CartesianArray3D() = default;
+        explicit CartesianArray3D(std::size_t size)
+            : m_x(size), m_y(size), m_z(size)
+        {}
+
+        static CartesianArray3D fromSpherical(const SphericalArray<T>& s)
+        {
+            CartesianArray3D c(s.size());
+            sphericalToCartesian<T>(s.view(), c.view());
+            return c;
+        }
+
+        static CartesianArray3D fromPoints(std::span<const CartesianPoint3D<T>> points)
+        {
+            CartesianArray3D c;
+            c.reserve(points.size());
+            for (const CartesianPoint3D<T>& point : points)
+                c.push_back(point);
+            return c;
+        }
+
+        void push_back(const CartesianPoint3D<T>& p)
+        {
+            m_x.push_back(p.getX());
+            m_y.push_back(p.getY());
+            m_z.push_back(p.getZ());
+        }
+
+        void resize(std::size_t size) { m_x.resize(size); m_y.resize(size); m_z.resize(size); }
+        void reserve(std::size_t size) { m_x.reserve(size); m_y.reserve(size); m_z.reserve(size); }
+        void clear() { m_x.clear(); m_y.clear(); m_z.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_x.size(); }
+        [[nodiscard]] bool empty() const { return m_x.empty(); }
+
+        [[nodiscard]] CartesianPoint3D<T> operator[](std::size_t i) const { return { m_x[i], m_y[i], m_z[i] }; }
+
+        [[nodiscard]] std::span<T> x() { return m_x; }
+        [[nodiscard]] std::span<const T> x() const { return m_x; }
+        [[nodiscard]] std::span<T> y() { return m_y; }
+        [[nodiscard]] std::span<const T> y() const { return m_y; }
+        [[nodiscard]] std::span<T> z() { return m_z; }
+        [[nodiscard]] std::span<const T> z() const { return m_z; }
+
+        [[nodiscard]] Cartesian3DSpan<T> view() { return { m_x, m_y, m_z }; }
+        [[nodiscard]] Cartesian3DSpan<const T> view() const { return { m_x, m_y, m_z }; }
+    private:
+        std::vector<T> m_x, m_y, m_z;
+    };
+}
+
+#endif //COORDSYSTEM_POINTARRAYS_H
@@ -0,0 +1,72 @@
+#include "PointSerializer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+
+namespace Coord
+{
+    namespace
+    {
+        // Sign, the 309 integer digits of DBL_MAX and the decimal point
+        constexpr std::size_t kMaxFixedChars { 311 };
+        // A whole number and its terminator always fit after Reserve()
+        constexpr std::size_t kMinBufferSize { kMaxFixedChars + PointSerializer::kMaxPrecision + 1 };
+    }
+
+    PointSerializer::PointSerializer(std::ostream& out, const SerializerOptions& options, const std::size_t bufferSize)
+        : m_out(out), m_options(options), m_buffer(std::max(bufferSize, kMinBufferSize))
+    {
+        m_options.precision = std::clamp(m_options.precision, 0, kMaxPrecision);
+    }
+
+    PointSerializer::~PointSerializer()
+    {
+        Flush();
+    }
+
+    void PointSerializer::Flush()
+    {
+        if (m_used > 0)
+            m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+        m_used = 0;
+        m_out.flush();
+    }
+
+    void PointSerializer::Reserve(const std::size_t size)
+    {
+        if (m_buffer.size() - m_used >= size)
+            return;
+
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+        m_used = 0;
+        if (m_buffer.size() < size)
+            m_buffer.resize(size);
+    }
+
+    void PointSerializer::Append(const std::string_view text, const char terminator)
+    {
+        Reserve(text.size() + 1);
+        std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+        m_used += text.size();
+        m_buffer[m_used++] = terminator;
+    }
+
+    void PointSerializer::Append(const double value, const char terminator)
+    {
+        const std::size_t maxSize { kMaxFixedChars + static_cast<std::size_t>(m_options.precision) + 1 };
+        Reserve(maxSize);
+
+        char* const first { m_buffer.data() + m_used };
+        const auto [end, ec] { std::to_chars(first, first + maxSize - 1, value, std::chars_format::fixed, m_options.precision) };
+        assert(ec == std::errc{});
+        *end = terminator;
+        m_used += static_cast<std::size_t>(end - first) + 1;
+    }
+
+    void PointSerializer::Append(const float value, const char terminator)
+    {
+        Append(static_cast<double>(value), terminator);
+    }
+}
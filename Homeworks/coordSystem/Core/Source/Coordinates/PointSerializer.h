@@ -0,0 +1,120 @@
+#ifndef COORDSYSTEM_POINTSERIALIZER_H
+#define COORDSYSTEM_POINTSERIALIZER_H
+
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Coordinates/PointArrays.h"
+
+// Bulk text output for the point arrays
+namespace Coord
+{
+    struct SerializerOptions
+    {
+        // ',' for CSV, '\t' for plain text tables
+        char separator{ ',' };
+        // Digits after the decimal point, at most kMaxPrecision
+        int precision{ 6 };
+        // First line with the column names
+        bool header{ true };
+    };
+
+    /**
+     * Writes point arrays row by row into one reusable buffer, numbers go through std::to_chars.
+     * The buffer is handed to the stream only when it's full, so nothing is allocated per point.
+     */
+    class PointSerializer
+    {
+    public:
+        static constexpr int kMaxPrecision { 17 };
+
+        explicit PointSerializer(std::ostream& out, const SerializerOptions& options = {}, std::size_t bufferSize = 1 << 16);
+        ~PointSerializer();
+
+        PointSerializer(const PointSerializer&) = delete;
+        PointSerializer& operator=(const PointSerializer&) = delete;
+
+        /**
+         * @param names One per column, written as the header if options.header is set
+         * @param columns All of the same size
+         */
+        template <typename T>
+        void WriteColumns(std::span<const std::string_view> names, std::span<const std::span<const T>> columns);
+
+        template <typename T>
+        void Write(const PolarArray<T>& points)
+        {
+            static constexpr std::string_view names[] { "radius", "theta" };
+            const std::span<const T> columns[] { points.radius(), points.theta() };
+            WriteColumns<T>(names, columns);
+        }
+
+        template <typename T>
+        void Write(const CartesianArray2D<T>& points)
+        {
+            static constexpr std::string_view names[] { "x", "y" };
+            const std::span<const T> columns[] { points.x(), points.y() };
+            WriteColumns<T>(names, columns);
+        }
+
+        template <typename T>
+        void Write(const SphericalArray<T>& points)
+        {
+            static constexpr std::string_view names[] { "radius", "theta", "phi" };
+            const std::span<const T> columns[] { points.radius(), points.theta(), points.polarAngle() };
+            WriteColumns<T>(names, columns);
+        }
+
+        template <typename T>
+        void Write(const CartesianArray3D<T>& points)
+        {
+            static constexpr std::string_view names[] { "x", "y", "z" };
+            const std::span<const T> columns[] { points.x(), points.y(), points.z() };
+            WriteColumns<T>(names, columns);
+        }
+
+        // Hands the buffered text to the stream and flushes it
+        void Flush();
+    private:
+        void Reserve(std::size_t size);
+        void Append(std::string_view text, char terminator);
+        void Append(double value, char terminator);
+        void Append(float value, char terminator);
+    private:
+        std::ostream& m_out;
+        SerializerOptions m_options;
+        std::vector<char> m_buffer;
+        std::size_t m_used{ 0 };
+    };
+
+    template <typename T>
+    void PointSerializer::WriteColumns(std::span<const std::string_view> names, std::span<const std::span<const T>> columns)
+    {
+        assert(names.size() == columns.size());
+        if (columns.empty())
+            return;
+
+        const std::size_t last { columns.size() - 1 };
+        if (m_options.header)
+        {
+            for (std::size_t c = 0; c < names.size(); ++c)
+                Append(names[c], c == last ? '\n' : m_options.separator);
+        }
+
+        const std::size_t rows { columns.front().size() };
+        for (const std::span<const T>& column : columns)
+            assert(column.size() == rows);
+
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            for (std::size_t c = 0; c < columns.size(); ++c)
+                Append(columns[c][i], c == last ? '\n' : m_options.separator);
+        }
+    }
+}
+
+#endif //COORDSYSTEM_POINTSERIALIZER_H
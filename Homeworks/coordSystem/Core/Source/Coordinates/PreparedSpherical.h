@@ -0,0 +1,213 @@
+#ifndef COORDSYSTEM_PREPAREDSPHERICAL_H
+#define COORDSYSTEM_PREPAREDSPHERICAL_H
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <vector>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/MathPolicy.h"
+#include "Coordinates/PointArrays.h"
+
+// Spherical points with their trig terms computed once. The direction is kept as a unit vector,
+// so a distance between prepared points is a dot product instead of five sin/cos calls, which
+// pays off when the same points (stations, a fixed catalogue) are queried many times.
+namespace Coord
+{
+    template <typename T = double>
+    struct PreparedSphericalPoint
+    {
+        template <typename Math = ExactMath, typename U>
+        static constexpr PreparedSphericalPoint fromSpherical(const BasicSphericalPoint<U>& p)
+        {
+            using Real = typename Math::Real;
+            Real sinPhi, cosPhi, sinTheta, cosTheta;
+            Math::sinCos(static_cast<Real>(p.getPolarAngle()), sinPhi, cosPhi);
+            Math::sinCos(static_cast<Real>(p.getTheta()), sinTheta, cosTheta);
+
+            const T x = sinPhi * cosTheta;
+            const T y = sinPhi * sinTheta;
+            const T z = cosPhi;
+            return { static_cast<T>(p.getRadius()), { x, y, z } };
+        }
+
+        // No trig at all, the point is only normalized. The origin gets the direction of +z like SphericalPoint
+        template <typename U>
+        static constexpr PreparedSphericalPoint fromCartesian(const CartesianPoint3D<U>& p)
+        {
+            const CartesianPoint3D<T> c { static_cast<T>(p.getX()), static_cast<T>(p.getY()), static_cast<T>(p.getZ()) };
+            const T length { norm(c) };
+            if (length == 0)
+                return { 0, { 0, 0, 1 } };
+
+            return { length, c / length };
+        }
+
+        [[nodiscard]] constexpr CartesianPoint3D<T> toCartesian() const { return unit * radius; }
+
+        T radius{};
+        CartesianPoint3D<T> unit{};
+    };
+
+    namespace Detail
+    {
+        // Rounding can push the dot product of two unit vectors just past 1
+        template <typename T>
+        constexpr T clampCosine(const T cosine) { return std::clamp(cosine, T(-1), T(1)); }
+
+        template <typename Math, typename T>
+        typename Math::Real centralAngle(const CartesianPoint3D<T>& u1, const CartesianPoint3D<T>& u2)
+        {
+            // atan2 of |sin| and cos stays accurate for nearly equal and nearly opposite points, unlike acos
+            using Real = typename Math::Real;
+            const CartesianPoint3D<T> c { cross(u1, u2) };
+            return Math::atan2(Math::sqrt(static_cast<Real>(squaredNorm(c))), static_cast<Real>(dot(u1, u2)));
+        }
+    }
+
+    // Same results as the SphericalPoint overloads in Distance.h
+
+    template <typename Math = ExactMath, typename T>
+    double distance3DChord(const PreparedSphericalPoint<T>& p1, const PreparedSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real r1 = static_cast<Real>(p1.radius);
+        const Real r2 = static_cast<Real>(p2.radius);
+        const Real cosine = static_cast<Real>(dot(p1.unit, p2.unit));
+        return Math::sqrt(std::max(r1 * r1 + r2 * r2 - 2 * r1 * r2 * cosine, Real(0)));
+    }
+
+    template <typename Math = ExactMath, typename T>
+    double distance3DArc(const PreparedSphericalPoint<T>& p1, const PreparedSphericalPoint<T>& p2)
+    {
+        using Real = typename Math::Real;
+        const Real radius = static_cast<Real>((p1.radius + p2.radius) / 2);
+        return radius * Math::acos(Detail::clampCosine(static_cast<Real>(dot(p1.unit, p2.unit))));
+    }
+
+    /**
+     * @return Distance along a sphere of sphereRadius between the directions of p1 and p2, radii are ignored
+     */
+    template <typename Math = ExactMath, typename T>
+    double greatCircleDistance(const PreparedSphericalPoint<T>& p1, const PreparedSphericalPoint<T>& p2, const double sphereRadius)
+    {
+        return sphereRadius * Detail::centralAngle<Math>(p1.unit, p2.unit);
+    }
+
+    /**
+     * Prepared points in columns: radius and the three unit vector components.
+     */
+    template <typename T = double>
+    class PreparedSphericalArray
+    {
+    public:
+        PreparedSphericalArray() = default;
+
+        template <typename Math = ExactMath, typename U>
+        static PreparedSphericalArray fromSpherical(const SphericalArray<U>& s)
+        {
+            PreparedSphericalArray p;
+            p.reserve(s.size());
+            for (std::size_t i = 0; i < s.size(); ++i)
+                p.push_back(PreparedSphericalPoint<T>::template fromSpherical<Math>(s[i]));
+            return p;
+        }
+
+        template <typename U>
+        static PreparedSphericalArray fromCartesian(const CartesianArray3D<U>& c)
+        {
+            PreparedSphericalArray p;
+            p.reserve(c.size());
+            for (std::size_t i = 0; i < c.size(); ++i)
+                p.push_back(PreparedSphericalPoint<T>::fromCartesian(c[i]));
+            return p;
+        }
+
+        void push_back(const PreparedSphericalPoint<T>& p)
+        {
+            m_radius.push_back(p.radius);
+            m_x.push_back(p.unit.x);
+            m_y.push_back(p.unit.y);
+            m_z.push_back(p.unit.z);
+        }
+
+        void reserve(std::size_t size) { m_radius.reserve(size); m_x.reserve(size); m_y.reserve(size); m_z.reserve(size); }
+        void clear() { m_radius.clear(); m_x.clear(); m_y.clear(); m_z.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_radius.size(); }
+        [[nodiscard]] bool empty() const { return m_radius.empty(); }
+
+        [[nodiscard]] PreparedSphericalPoint<T> operator[](std::size_t i) const { return { m_radius[i], { m_x[i], m_y[i], m_z[i] } }; }
+
+        [[nodiscard]] std::span<const T> radius() const { return m_radius; }
+        // Unit vector components
+        [[nodiscard]] std::span<const T> x() const { return m_x; }
+        [[nodiscard]] std::span<const T> y() const { return m_y; }
+        [[nodiscard]] std::span<const T> z() const { return m_z; }
+    private:
+        std::vector<T> m_radius, m_x, m_y, m_z;
+    };
+
+    // One-to-many: out[i] is the distance from "from" to to[i]. out must have the size of to.
+    // The loops are plain column arithmetic so the compiler can vectorize them.
+
+    template <typename Math = ExactMath, typename T>
+    void distance3DChord(const PreparedSphericalPoint<T>& from, const PreparedSphericalArray<T>& to, std::span<double> out)
+    {
+        assert(out.size() == to.size());
+        using Real = typename Math::Real;
+        const Real r1 { static_cast<Real>(from.radius) };
+        const CartesianPoint3D<Real> u1 { static_cast<Real>(from.unit.x), static_cast<Real>(from.unit.y), static_cast<Real>(from.unit.z) };
+
+        const T* radius { to.radius().data() };
+        const T* x { to.x().data() };
+        const T* y { to.y().data() };
+        const T* z { to.z().data() };
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            const Real r2 { static_cast<Real>(radius[i]) };
+            const Real cosine { u1.x * static_cast<Real>(x[i]) + u1.y * static_cast<Real>(y[i]) + u1.z * static_cast<Real>(z[i]) };
+            out[i] = Math::sqrt(std::max(r1 * r1 + r2 * r2 - 2 * r1 * r2 * cosine, Real(0)));
+        }
+    }
+
+    template <typename Math = ExactMath, typename T>
+    void distance3DArc(const PreparedSphericalPoint<T>& from, const PreparedSphericalArray<T>& to, std::span<double> out)
+    {
+        assert(out.size() == to.size());
+        using Real = typename Math::Real;
+        const Real r1 { static_cast<Real>(from.radius) };
+        const CartesianPoint3D<Real> u1 { static_cast<Real>(from.unit.x), static_cast<Real>(from.unit.y), static_cast<Real>(from.unit.z) };
+
+        const T* radius { to.radius().data() };
+        const T* x { to.x().data() };
+        const T* y { to.y().data() };
+        const T* z { to.z().data() };
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            const Real cosine { u1.x * static_cast<Real>(x[i]) + u1.y * static_cast<Real>(y[i]) + u1.z * static_cast<Real>(z[i]) };
+            out[i] = (r1 + static_cast<Real>(radius[i])) / 2 * Math::acos(Detail::clampCosine(cosine));
+        }
+    }
+
+    template <typename Math = ExactMath, typename T>
+    void greatCircleDistance(const PreparedSphericalPoint<T>& from, const PreparedSphericalArray<T>& to,
+                             const double sphereRadius, std::span<double> out)
+    {
+        assert(out.size() == to.size());
+        using Real = typename Math::Real;
+        const CartesianPoint3D<Real> u1 { static_cast<Real>(from.unit.x), static_cast<Real>(from.unit.y), static_cast<Real>(from.unit.z) };
+
+        const T* x { to.x().data() };
+        const T* y { to.y().data() };
+        const T* z { to.z().data() };
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            const CartesianPoint3D<Real> u2 { static_cast<Real>(x[i]), static_cast<Real>(y[i]), static_cast<Real>(z[i]) };
+            out[i] = sphereRadius * Detail::centralAngle<Math>(u1, u2);
+        }
+    }
+}
+
+#endif //COORDSYSTEM_PREPAREDSPHERICAL_H
@@ -0,0 +1,374 @@
+#ifndef COORDSYSTEM_QUANTIZEDARRAYS_H
+#define COORDSYSTEM_QUANTIZEDARRAYS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/PointArrays.h"
+#include "Coordinates/Simd/SimdMath.h"
+
+// Compact storage for large point clouds. Coordinates are kept in a smaller encoding and decoded
+// into compute precision when loaded, either one point at a time or a block of columns at once.
+//
+// Codecs:
+//   Float32Codec            - float, ~7 significant digits, half of double
+//   FixedPointCodec<int32_t> - value = stored * scale, uniform absolute error of scale / 2
+//   FixedPointCodec<int16_t> - the same in a quarter of double
+// Fixed point codecs have no default, pass Codec::forRange or a scale for every column that isn't an angle.
+namespace Coord
+{
+    struct Float32Codec
+    {
+        using Stored = float;
+
+        // Floats need no range, kept so every codec can be made the same way
+        static Float32Codec forRange(double) { return {}; }
+
+        [[nodiscard]] Stored encode(const double value) const { return static_cast<Stored>(value); }
+        [[nodiscard]] double decode(const Stored value) const { return value; }
+    };
+
+    template <std::signed_integral I>
+    struct FixedPointCodec
+    {
+        using Stored = I;
+
+        // No default, a scale that doesn't fit the data would clamp or round it away unnoticed
+        explicit FixedPointCodec(const double scale)
+            : scale{ scale }, inverseScale{ 1.0 / scale }
+        {
+            assert(scale > 0.0);
+        }
+
+        /**
+         * @return Codec with the finest scale that still holds [-maxAbs, maxAbs]
+         */
+        static FixedPointCodec forRange(const double maxAbs)
+        {
+            return FixedPointCodec{ maxAbs / std::numeric_limits<Stored>::max() };
+        }
+
+        // Values out of range are clamped to the largest stored value, NaN is stored as 0
+        [[nodiscard]] Stored encode(const double value) const
+        {
+            if (std::isnan(value))
+                return 0;
+
+            const double scaled { std::round(value * inverseScale) };
+            return static_cast<Stored>(std::clamp(scaled,
+                                                  static_cast<double>(std::numeric_limits<Stored>::min()),
+                                                  static_cast<double>(std::numeric_limits<Stored>::max())));
+        }
+
+        [[nodiscard]] double decode(const Stored value) const { return value * scale; }
+
+        double scale;
+        double inverseScale;
+    };
+
+    using FixedPoint32Codec = FixedPointCodec<std::int32_t>;
+    using FixedPoint16Codec = FixedPointCodec<std::int16_t>;
+
+    /**
+     * One coordinate column in a codec's encoding.
+     */
+    template <typename Codec>
+    class QuantizedColumn
+    {
+    public:
+        using Stored = typename Codec::Stored;
+
+        explicit QuantizedColumn(const Codec& codec = {})
+            : m_codec{ codec }
+        {}
+
+        void push_back(const double value) { m_data.push_back(m_codec.encode(value)); }
+
+        void assign(std::span<const double> values)
+        {
+            m_data.resize(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+                m_data[i] = m_codec.encode(values[i]);
+        }
+
+        /**
+         * Decodes [offset, offset + out.size()) into out
+         */
+        template <typename T>
+        void load(const std::size_t offset, std::span<T> out) const
+        {
+            assert(offset + out.size() <= m_data.size());
+            const Stored* data { m_data.data() + offset };
+            for (std::size_t i = 0; i < out.size(); ++i)
+                out[i] = static_cast<T>(m_codec.decode(data[i]));
+        }
+
+        void resize(std::size_t size) { m_data.resize(size); }
+        void reserve(std::size_t size) { m_data.reserve(size); }
+        void clear() { m_data.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_data.size(); }
+        [[nodiscard]] double operator[](std::size_t i) const { return m_codec.decode(m_data[i]); }
+
+        [[nodiscard]] const Codec& codec() const { return m_codec; }
+        [[nodiscard]] std::span<const Stored> stored() const { return m_data; }
+        [[nodiscard]] std::size_t memoryUsage() const { return m_data.size() * sizeof(Stored); }
+    private:
+        Codec m_codec;
+        std::vector<Stored> m_data;
+    };
+
+    // Angles in [-2pi, 2pi] cover both [-pi, pi] and [0, 2pi) azimuths, so their codec needs no setup
+    template <typename Codec>
+    Codec angleCodec() { return Codec::forRange(2.0 * Simd::kPi); }
+
+    /**
+     * Encoded counterpart of PolarArray. Loads decode into any compute precision T.
+     */
+    template <typename Codec = Float32Codec>
+    class QuantizedPolarArray
+    {
+    public:
+        explicit QuantizedPolarArray(const Codec& radius = {}, const Codec& theta = angleCodec<Codec>())
+            : m_radius{ radius }, m_theta{ theta }
+        {}
+
+        template <typename T>
+        static QuantizedPolarArray fromArray(const PolarArray<T>& points, const Codec& radius = {}, const Codec& theta = angleCodec<Codec>())
+        {
+            QuantizedPolarArray q{ radius, theta };
+            q.reserve(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+                q.push_back(points[i]);
+            return q;
+        }
+
+        template <typename T>
+        void push_back(const BasicPolarPoint<T>& p)
+        {
+            m_radius.push_back(p.getRadius());
+            m_theta.push_back(p.getTheta());
+        }
+
+        void reserve(std::size_t size) { m_radius.reserve(size); m_theta.reserve(size); }
+        void clear() { m_radius.clear(); m_theta.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_radius.size(); }
+        [[nodiscard]] bool empty() const { return m_radius.size() == 0; }
+
+        [[nodiscard]] PolarPoint operator[](std::size_t i) const { return { m_radius[i], m_theta[i] }; }
+
+        // Decodes the points from offset on, as many as out holds
+        template <typename T>
+        void load(const std::size_t offset, PolarSpan<T> out) const
+        {
+            m_radius.load(offset, out.radius);
+            m_theta.load(offset, out.theta);
+        }
+
+        template <typename T = double>
+        [[nodiscard]] PolarArray<T> toArray() const
+        {
+            PolarArray<T> p(size());
+            load<T>(0, p.view());
+            return p;
+        }
+
+        [[nodiscard]] const QuantizedColumn<Codec>& radius() const { return m_radius; }
+        [[nodiscard]] const QuantizedColumn<Codec>& theta() const { return m_theta; }
+
+        [[nodiscard]] std::size_t memoryUsage() const { return m_radius.memoryUsage() + m_theta.memoryUsage(); }
+    private:
+        QuantizedColumn<Codec> m_radius, m_theta;
+    };
+
+    template <typename Codec = Float32Codec>
+    class QuantizedCartesianArray2D
+    {
+    public:
+        // One codec for both axes, so distances are scaled the same in every direction
+        explicit QuantizedCartesianArray2D(const Codec& codec = {})
+            : m_x{ codec }, m_y{ codec }
+        {}
+
+        template <typename T>
+        static QuantizedCartesianArray2D fromArray(const CartesianArray2D<T>& points, const Codec& codec = {})
+        {
+            QuantizedCartesianArray2D q{ codec };
+            q.reserve(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+                q.push_back(points[i]);
+            return q;
+        }
+
+        template <typename T>
+        void push_back(const CartesianPoint2D<T>& p)
+        {
+            m_x.push_back(p.getX());
+            m_y.push_back(p.getY());
+        }
+
+        void reserve(std::size_t size) { m_x.reserve(size); m_y.reserve(size); }
+        void clear() { m_x.clear(); m_y.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_x.size(); }
+        [[nodiscard]] bool empty() const { return m_x.size() == 0; }
+
+        [[nodiscard]] CartesianPoint2D<double> operator[](std::size_t i) const { return { m_x[i], m_y[i] }; }
+
+        template <typename T>
+        void load(const std::size_t offset, Cartesian2DSpan<T> out) const
+        {
+            m_x.load(offset, out.x);
+            m_y.load(offset, out.y);
+        }
+
+        template <typename T = double>
+        [[nodiscard]] CartesianArray2D<T> toArray() const
+        {
+            CartesianArray2D<T> c(size());
+            load<T>(0, c.view());
+            return c;
+        }
+
+        [[nodiscard]] const QuantizedColumn<Codec>& x() const { return m_x; }
+        [[nodiscard]] const QuantizedColumn<Codec>& y() const { return m_y; }
+
+        [[nodiscard]] std::size_t memoryUsage() const { return m_x.memoryUsage() + m_y.memoryUsage(); }
+    private:
+        QuantizedColumn<Codec> m_x, m_y;
+    };
+
+    template <typename Codec = Float32Codec>
+    class QuantizedSphericalArray
+    {
+    public:
+        explicit QuantizedSphericalArray(const Codec& radius = {}, const Codec& theta = angleCodec<Codec>(),
+                                         const Codec& polarAngle = angleCodec<Codec>())
+            : m_radius{ radius }, m_theta{ theta }, m_polarAngle{ polarAngle }
+        {}
+
+        template <typename T>
+        static QuantizedSphericalArray fromArray(const SphericalArray<T>& points, const Codec& radius = {},
+                                                 const Codec& theta = angleCodec<Codec>(),
+                                                 const Codec& polarAngle = angleCodec<Codec>())
+        {
+            QuantizedSphericalArray q{ radius, theta, polarAngle };
+            q.reserve(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+                q.push_back(points[i]);
+            return q;
+        }
+
+        template <typename T>
+        void push_back(const BasicSphericalPoint<T>& p)
+        {
+            m_radius.push_back(p.getRadius());
+            m_theta.push_back(p.getTheta());
+            m_polarAngle.push_back(p.getPolarAngle());
+        }
+
+        void reserve(std::size_t size) { m_radius.reserve(size); m_theta.reserve(size); m_polarAngle.reserve(size); }
+        void clear() { m_radius.clear(); m_theta.clear(); m_polarAngle.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_radius.size(); }
+        [[nodiscard]] bool empty() const { return m_radius.size() == 0; }
+
+        [[nodiscard]] SphericalPoint operator[](std::size_t i) const { return { m_radius[i], m_theta[i], m_polarAngle[i] }; }
+
+        template <typename T>
+        void load(const std::size_t offset, SphericalSpan<T> out) const
+        {
+            m_radius.load(offset, out.radius);
+            m_theta.load(offset, out.theta);
+            m_polarAngle.load(offset, out.polarAngle);
+        }
+
+        template <typename T = double>
+        [[nodiscard]] SphericalArray<T> toArray() const
+        {
+            SphericalArray<T> s(size());
+            load<T>(0, s.view());
+            return s;
+        }
+
+        [[nodiscard]] const QuantizedColumn<Codec>& radius() const { return m_radius; }
+        [[nodiscard]] const QuantizedColumn<Codec>& theta() const { return m_theta; }
+        [[nodiscard]] const QuantizedColumn<Codec>& polarAngle() const { return m_polarAngle; }
+
+        [[nodiscard]] std::size_t memoryUsage() const
+        {
+            return m_radius.memoryUsage() + m_theta.memoryUsage() + m_polarAngle.memoryUsage();
+        }
+    private:
+        QuantizedColumn<Codec> m_radius, m_theta, m_polarAngle;
+    };
+
+    template <typename Codec = Float32Codec>
+    class QuantizedCartesianArray3D
+    {
+    public:
+        explicit QuantizedCartesianArray3D(const Codec& codec = {})
+            : m_x{ codec }, m_y{ codec }, m_z{ codec }
+        {}
+
+        template <typename T>
+        static QuantizedCartesianArray3D fromArray(const CartesianArray3D<T>& points, const Codec& codec = {})
+        {
+            QuantizedCartesianArray3D q{ codec };
+            q.reserve(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+                q.push_back(points[i]);
+            return q;
+        }
+
+        template <typename T>
+        void push_back(const CartesianPoint3D<T>& p)
+        {
+            m_x.push_back(p.getX());
+            m_y.push_back(p.getY());
+            m_z.push_back(p.getZ());
+        }
+
+        void reserve(std::size_t size) { m_x.reserve(size); m_y.reserve(size); m_z.reserve(size); }
+        void clear() { m_x.clear(); m_y.clear(); m_z.clear(); }
+
+        [[nodiscard]] std::size_t size() const { return m_x.size(); }
+        [[nodiscard]] bool empty() const { return m_x.size() == 0; }
+
+        [[nodiscard]] CartesianPoint3D<double> operator[](std::size_t i) const { return { m_x[i], m_y[i], m_z[i] }; }
+
+        template <typename T>
+        void load(const std::size_t offset, Cartesian3DSpan<T> out) const
+        {
+            m_x.load(offset, out.x);
+            m_y.load(offset, out.y);
+            m_z.load(offset, out.z);
+        }
+
+        template <typename T = double>
+        [[nodiscard]] CartesianArray3D<T> toArray() const
+        {
+            CartesianArray3D<T> c(size());
+            load<T>(0, c.view());
+            return c;
+        }
+
+        [[nodiscard]] const QuantizedColumn<Codec>& x() const { return m_x; }
+        [[nodiscard]] const QuantizedColumn<Codec>& y() const { return m_y; }
+        [[nodiscard]] const QuantizedColumn<Codec>& z() const { return m_z; }
+
+        [[nodiscard]] std::size_t memoryUsage() const { return m_x.memoryUsage() + m_y.memoryUsage() + m_z.memoryUsage(); }
+    private:
+        QuantizedColumn<Codec> m_x, m_y, m_z;
+    };
+}
+
+#endif //COORDSYSTEM_QUANTIZEDARRAYS_H
@@ -0,0 +1,143 @@
+#ifndef COORDSYSTEM_CONVERSIONKERNELS_H
+#define COORDSYSTEM_CONVERSIONKERNELS_H
+
+#include <cstddef>
+
+#include "Coordinates/Simd/SimdMath.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define COORD_SIMD_X86 1
+#else
+    #define COORD_SIMD_X86 0
+#endif
+
+namespace Coord::Simd
+{
+    struct ConversionKernels
+    {
+        void (*polarToCartesian)(const double* radius, const double* theta,
+                                 double* x, double* y, std::size_t count);
+        void (*cartesianToPolar)(const double* x, const double* y,
+                                 double* radius, double* theta, std::size_t count);
+        void (*sphericalToCartesian)(const double* radius, const double* theta, const double* polarAngle,
+                                     double* x, double* y, double* z, std::size_t count);
+        void (*cartesianToSpherical)(const double* x, const double* y, const double* z,
+                                     double* radius, double* theta, double* polarAngle, std::size_t count);
+    };
+
+    // Each one lives in its own translation unit compiled for that instruction set.
+    // They return nullptr when the instruction set isn't available for the target architecture.
+    const ConversionKernels* getSSE42Kernels();
+    const ConversionKernels* getAVX2Kernels();
+    const ConversionKernels* getAVX512Kernels();
+
+    // Runs block(in, out) over full vectors and pads the remainder into one more vector,
+    // so no scalar code ends up compiled for the wider instruction set.
+    template <typename V, std::size_t In, std::size_t Out, typename Block>
+    void forEachBlock(const double* const (&in)[In], double* const (&out)[Out], const std::size_t count, Block block)
+    {
+        V inLanes[In], outLanes[Out];
+
+        std::size_t i { 0 };
+        for (; i + V::Width <= count; i += V::Width)
+        {
+            for (std::size_t c = 0; c < In; ++c)
+                inLanes[c] = V::load(in[c] + i);
+
+            block(inLanes, outLanes);
+
+            for (std::size_t c = 0; c < Out; ++c)
+                outLanes[c].store(out[c] + i);
+        }
+
+        const std::size_t rest { count - i };
+        if (rest == 0)
+            return;
+
+        double buffer[V::Width];
+        for (std::size_t c = 0; c < In; ++c)
+        {
+            for (std::size_t lane = 0; lane < V::Width; ++lane)
+                buffer[lane] = lane < rest ? in[c][i + lane] : 0.0;
+            inLanes[c] = V::load(buffer);
+        }
+
+        block(inLanes, outLanes);
+
+        for (std::size_t c = 0; c < Out; ++c)
+        {
+            outLanes[c].store(buffer);
+            for (std::size_t lane = 0; lane < rest; ++lane)
+                out[c][i + lane] = buffer[lane];
+        }
+    }
+
+    template <typename V>
+    void polarToCartesian(const double* radius, const double* theta, double* x, double* y, const std::size_t count)
+    {
+        forEachBlock<V>({ radius, theta }, { x, y }, count, [](const V (&in)[2], V (&out)[2])
+        {
+            V sin, cos;
+            sinCos(in[1], sin, cos);
+            out[0] = in[0] * cos;
+            out[1] = in[0] * sin;
+        });
+    }
+
+    template <typename V>
+    void cartesianToPolar(const double* x, const double* y, double* radius, double* theta, const std::size_t count)
+    {
+        forEachBlock<V>({ x, y }, { radius, theta }, count, [](const V (&in)[2], V (&out)[2])
+        {
+            out[0] = sqrt(mulAdd(in[0], in[0], in[1] * in[1]));
+            out[1] = atan2(in[1], in[0]);
+        });
+    }
+
+    template <typename V>
+    void sphericalToCartesian(const double* radius, const double* theta, const double* polarAngle,
+                              double* x, double* y, double* z, const std::size_t count)
+    {
+        forEachBlock<V>({ radius, theta, polarAngle }, { x, y, z }, count, [](const V (&in)[3], V (&out)[3])
+        {
+            V sinTheta, cosTheta, sinPhi, cosPhi;
+            sinCos(in[1], sinTheta, cosTheta);
+            sinCos(in[2], sinPhi, cosPhi);
+
+            const V planar { in[0] * sinPhi };
+            out[0] = planar * cosTheta;
+            out[1] = planar * sinTheta;
+            out[2] = in[0] * cosPhi;
+        });
+    }
+
+    template <typename V>
+    void cartesianToSpherical(const double* x, const double* y, const double* z,
+                              double* radius, double* theta, double* polarAngle, const std::size_t count)
+    {
+        forEachBlock<V>({ x, y, z }, { radius, theta, polarAngle }, count, [](const V (&in)[3], V (&out)[3])
+        {
+            const V planarSquared { mulAdd(in[0], in[0], in[1] * in[1]) };
+            const V rho { sqrt(mulAdd(in[2], in[2], planarSquared)) };
+            const auto origin { rho == V(0.0) };
+
+            // atan2(planar, z) instead of acos(z / rho): same angle, no precision loss near the poles
+            out[0] = rho;
+            out[1] = select(origin, V(0.0), atan2(in[1], in[0]));
+            out[2] = select(origin, V(0.0), atan2(sqrt(planarSquared), in[2]));
+        });
+    }
+
+    template <typename V>
+    constexpr ConversionKernels makeConversionKernels()
+    {
+        return {
+            &polarToCartesian<V>,
+            &cartesianToPolar<V>,
+            &sphericalToCartesian<V>,
+            &cartesianToSpherical<V>
+        };
+    }
+}
+
+#endif //COORDSYSTEM_CONVERSIONKERNELS_H
@@ -0,0 +1,94 @@
+#include "Coordinates/Simd/ConversionKernels.h"
+#include "Coordinates/Simd/DistanceKernels.h"
+#include "Coordinates/Simd/TransformKernels.h"
+
+// Compiled with -mavx2 -mfma (see Core/CMakeLists.txt)
+#if COORD_SIMD_X86
+
+#include <immintrin.h>
+
+namespace Coord::Simd
+{
+    namespace
+    {
+        struct MaskAVX2
+        {
+            __m256d v;
+
+            friend MaskAVX2 operator&(MaskAVX2 a, MaskAVX2 b) { return { _mm256_and_pd(a.v, b.v) }; }
+            friend MaskAVX2 operator|(MaskAVX2 a, MaskAVX2 b) { return { _mm256_or_pd(a.v, b.v) }; }
+            friend bool anyOf(MaskAVX2 m) { return _mm256_movemask_pd(m.v) != 0; }
+        };
+
+        struct VecAVX2
+        {
+            using Scalar = double;
+            static constexpr std::size_t Width { 4 };
+
+            __m256d v;
+
+            VecAVX2() = default;
+            VecAVX2(__m256d value) : v{ value } {}
+            VecAVX2(double value) : v{ _mm256_set1_pd(value) } {}
+
+            static VecAVX2 load(const double* p) { return _mm256_loadu_pd(p); }
+            void store(double* p) const { _mm256_storeu_pd(p, v); }
+
+            friend VecAVX2 operator+(VecAVX2 a, VecAVX2 b) { return _mm256_add_pd(a.v, b.v); }
+            friend VecAVX2 operator-(VecAVX2 a, VecAVX2 b) { return _mm256_sub_pd(a.v, b.v); }
+            friend VecAVX2 operator*(VecAVX2 a, VecAVX2 b) { return _mm256_mul_pd(a.v, b.v); }
+            friend VecAVX2 operator/(VecAVX2 a, VecAVX2 b) { return _mm256_div_pd(a.v, b.v); }
+            friend VecAVX2 operator-(VecAVX2 a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+
+            friend MaskAVX2 operator==(VecAVX2 a, VecAVX2 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; }
+            friend MaskAVX2 operator<(VecAVX2 a, VecAVX2 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+            friend MaskAVX2 operator>(VecAVX2 a, VecAVX2 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+            friend MaskAVX2 operator>=(VecAVX2 a, VecAVX2 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+
+            friend VecAVX2 mulAdd(VecAVX2 a, VecAVX2 b, VecAVX2 c) { return _mm256_fmadd_pd(a.v, b.v, c.v); }
+            friend VecAVX2 sqrt(VecAVX2 a) { return _mm256_sqrt_pd(a.v); }
+            friend VecAVX2 abs(VecAVX2 a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+            friend VecAVX2 floor(VecAVX2 a) { return _mm256_floor_pd(a.v); }
+            friend VecAVX2 roundNearest(VecAVX2 a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            friend VecAVX2 min(VecAVX2 a, VecAVX2 b) { return _mm256_min_pd(a.v, b.v); }
+            friend VecAVX2 max(VecAVX2 a, VecAVX2 b) { return _mm256_max_pd(a.v, b.v); }
+
+            friend VecAVX2 copySign(VecAVX2 magnitude, VecAVX2 sign)
+            {
+                const __m256d signBit { _mm256_set1_pd(-0.0) };
+                return _mm256_or_pd(_mm256_andnot_pd(signBit, magnitude.v), _mm256_and_pd(signBit, sign.v));
+            }
+
+            friend VecAVX2 select(MaskAVX2 m, VecAVX2 a, VecAVX2 b) { return _mm256_blendv_pd(b.v, a.v, m.v); }
+        };
+    }
+
+    const ConversionKernels* getAVX2Kernels()
+    {
+        static constexpr ConversionKernels kernels { makeConversionKernels<VecAVX2>() };
+        return &kernels;
+    }
+
+    const DistanceKernels* getAVX2DistanceKernels()
+    {
+        static constexpr DistanceKernels kernels { makeDistanceKernels<VecAVX2>() };
+        return &kernels;
+    }
+
+    const TransformKernels* getAVX2TransformKernels()
+    {
+        static constexpr TransformKernels kernels { makeTransformKernels<VecAVX2>() };
+        return &kernels;
+    }
+}
+
+#else
+
+namespace Coord::Simd
+{
+    const ConversionKernels* getAVX2Kernels() { return nullptr; }
+    const DistanceKernels* getAVX2DistanceKernels() { return nullptr; }
+    const TransformKernels* getAVX2TransformKernels() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "Coordinates/Simd/ConversionKernels.h"
+#include "Coordinates/Simd/DistanceKernels.h"
+#include "Coordinates/Simd/TransformKernels.h"
+
+// Compiled with -mavx512f -mfma (see Core/CMakeLists.txt). Only AVX-512F instructions are used.
+#if COORD_SIMD_X86
+
+#include <immintrin.h>
+
+namespace Coord::Simd
+{
+    namespace
+    {
+        struct MaskAVX512
+        {
+            __mmask8 v;
+
+            friend MaskAVX512 operator&(MaskAVX512 a, MaskAVX512 b) { return { static_cast<__mmask8>(a.v & b.v) }; }
+            friend MaskAVX512 operator|(MaskAVX512 a, MaskAVX512 b) { return { static_cast<__mmask8>(a.v | b.v) }; }
+            friend bool anyOf(MaskAVX512 m) { return m.v != 0; }
+        };
+
+        struct VecAVX512
+        {
+            using Scalar = double;
+            static constexpr std::size_t Width { 8 };
+
+            // Bitwise double ops are AVX-512DQ, so sign manipulation goes through the integer domain
+            static constexpr long long signBit { static_cast<long long>(0x8000000000000000ULL) };
+
+            __m512d v;
+
+            VecAVX512() = default;
+            VecAVX512(__m512d value) : v{ value } {}
+            VecAVX512(double value) : v{ _mm512_set1_pd(value) } {}
+
+            static VecAVX512 load(const double* p) { return _mm512_loadu_pd(p); }
+            void store(double* p) const { _mm512_storeu_pd(p, v); }
+
+            friend VecAVX512 operator+(VecAVX512 a, VecAVX512 b) { return _mm512_add_pd(a.v, b.v); }
+            friend VecAVX512 operator-(VecAVX512 a, VecAVX512 b) { return _mm512_sub_pd(a.v, b.v); }
+            friend VecAVX512 operator*(VecAVX512 a, VecAVX512 b) { return _mm512_mul_pd(a.v, b.v); }
+            friend VecAVX512 operator/(VecAVX512 a, VecAVX512 b) { return _mm512_div_pd(a.v, b.v); }
+            friend VecAVX512 operator-(VecAVX512 a)
+            {
+                return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(signBit)));
+            }
+
+            friend MaskAVX512 operator==(VecAVX512 a, VecAVX512 b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ) }; }
+            friend MaskAVX512 operator<(VecAVX512 a, VecAVX512 b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ) }; }
+            friend MaskAVX512 operator>(VecAVX512 a, VecAVX512 b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ) }; }
+            friend MaskAVX512 operator>=(VecAVX512 a, VecAVX512 b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ) }; }
+
+            friend VecAVX512 mulAdd(VecAVX512 a, VecAVX512 b, VecAVX512 c) { return _mm512_fmadd_pd(a.v, b.v, c.v); }
+            friend VecAVX512 sqrt(VecAVX512 a) { return _mm512_sqrt_pd(a.v); }
+            friend VecAVX512 abs(VecAVX512 a) { return _mm512_abs_pd(a.v); }
+            friend VecAVX512 floor(VecAVX512 a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            friend VecAVX512 roundNearest(VecAVX512 a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            friend VecAVX512 min(VecAVX512 a, VecAVX512 b) { return _mm512_min_pd(a.v, b.v); }
+            friend VecAVX512 max(VecAVX512 a, VecAVX512 b) { return _mm512_max_pd(a.v, b.v); }
+
+            friend VecAVX512 copySign(VecAVX512 magnitude, VecAVX512 sign)
+            {
+                const __m512i mask { _mm512_set1_epi64(signBit) };
+                const __m512i bits { _mm512_or_si512(
+                    _mm512_andnot_si512(mask, _mm512_castpd_si512(magnitude.v)),
+                    _mm512_and_si512(mask, _mm512_castpd_si512(sign.v))) };
+                return _mm512_castsi512_pd(bits);
+            }
+
+            friend VecAVX512 select(MaskAVX512 m, VecAVX512 a, VecAVX512 b) { return _mm512_mask_blend_pd(m.v, b.v, a.v); }
+        };
+    }
+
+    const ConversionKernels* getAVX512Kernels()
+    {
+        static constexpr ConversionKernels kernels { makeConversionKernels<VecAVX512>() };
+        return &kernels;
+    }
+
+    const DistanceKernels* getAVX512DistanceKernels()
+    {
+        static constexpr DistanceKernels kernels { makeDistanceKernels<VecAVX512>() };
+        return &kernels;
+    }
+
+    const TransformKernels* getAVX512TransformKernels()
+    {
+        static constexpr TransformKernels kernels { makeTransformKernels<VecAVX512>() };
+        return &kernels;
+    }
+}
+
+#else
+
+namespace Coord::Simd
+{
+    const ConversionKernels* getAVX512Kernels() { return nullptr; }
+    const DistanceKernels* getAVX512DistanceKernels() { return nullptr; }
+    const TransformKernels* getAVX512TransformKernels() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "Coordinates/Simd/ConversionKernels.h"
+#include "Coordinates/Simd/DistanceKernels.h"
+#include "Coordinates/Simd/TransformKernels.h"
+
+// Compiled with -msse4.2 (see Core/CMakeLists.txt)
+#if COORD_SIMD_X86
+
+#include <immintrin.h>
+
+namespace Coord::Simd
+{
+    namespace
+    {
+        struct MaskSSE
+        {
+            __m128d v;
+
+            friend MaskSSE operator&(MaskSSE a, MaskSSE b) { return { _mm_and_pd(a.v, b.v) }; }
+            friend MaskSSE operator|(MaskSSE a, MaskSSE b) { return { _mm_or_pd(a.v, b.v) }; }
+            friend bool anyOf(MaskSSE m) { return _mm_movemask_pd(m.v) != 0; }
+        };
+
+        struct VecSSE
+        {
+            using Scalar = double;
+            static constexpr std::size_t Width { 2 };
+
+            __m128d v;
+
+            VecSSE() = default;
+            VecSSE(__m128d value) : v{ value } {}
+            VecSSE(double value) : v{ _mm_set1_pd(value) } {}
+
+            static VecSSE load(const double* p) { return _mm_loadu_pd(p); }
+            void store(double* p) const { _mm_storeu_pd(p, v); }
+
+            friend VecSSE operator+(VecSSE a, VecSSE b) { return _mm_add_pd(a.v, b.v); }
+            friend VecSSE operator-(VecSSE a, VecSSE b) { return _mm_sub_pd(a.v, b.v); }
+            friend VecSSE operator*(VecSSE a, VecSSE b) { return _mm_mul_pd(a.v, b.v); }
+            friend VecSSE operator/(VecSSE a, VecSSE b) { return _mm_div_pd(a.v, b.v); }
+            friend VecSSE operator-(VecSSE a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.0)); }
+
+            friend MaskSSE operator==(VecSSE a, VecSSE b) { return { _mm_cmpeq_pd(a.v, b.v) }; }
+            friend MaskSSE operator<(VecSSE a, VecSSE b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+            friend MaskSSE operator>(VecSSE a, VecSSE b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+            friend MaskSSE operator>=(VecSSE a, VecSSE b) { return { _mm_cmpge_pd(a.v, b.v) }; }
+
+            // No FMA before AVX2
+            friend VecSSE mulAdd(VecSSE a, VecSSE b, VecSSE c) { return _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v); }
+            friend VecSSE sqrt(VecSSE a) { return _mm_sqrt_pd(a.v); }
+            friend VecSSE abs(VecSSE a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+            friend VecSSE floor(VecSSE a) { return _mm_floor_pd(a.v); }
+            friend VecSSE roundNearest(VecSSE a) { return _mm_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            friend VecSSE min(VecSSE a, VecSSE b) { return _mm_min_pd(a.v, b.v); }
+            friend VecSSE max(VecSSE a, VecSSE b) { return _mm_max_pd(a.v, b.v); }
+
+            friend VecSSE copySign(VecSSE magnitude, VecSSE sign)
+            {
+                const __m128d signBit { _mm_set1_pd(-0.0) };
+                return _mm_or_pd(_mm_andnot_pd(signBit, magnitude.v), _mm_and_pd(signBit, sign.v));
+            }
+
+            friend VecSSE select(MaskSSE m, VecSSE a, VecSSE b) { return _mm_blendv_pd(b.v, a.v, m.v); }
+        };
+    }
+
+    const ConversionKernels* getSSE42Kernels()
+    {
+        static constexpr ConversionKernels kernels { makeConversionKernels<VecSSE>() };
+        return &kernels;
+    }
+
+    const DistanceKernels* getSSE42DistanceKernels()
+    {
+        static constexpr DistanceKernels kernels { makeDistanceKernels<VecSSE>() };
+        return &kernels;
+    }
+
+    const TransformKernels* getSSE42TransformKernels()
+    {
+        static constexpr TransformKernels kernels { makeTransformKernels<VecSSE>() };
+        return &kernels;
+    }
+}
+
+#else
+
+namespace Coord::Simd
+{
+    const ConversionKernels* getSSE42Kernels() { return nullptr; }
+    const DistanceKernels* getSSE42DistanceKernels() { return nullptr; }
+    const TransformKernels* getSSE42TransformKernels() { return nullptr; }
+}
+
+#endif
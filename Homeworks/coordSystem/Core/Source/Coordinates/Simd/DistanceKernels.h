@@ -0,0 +1,345 @@
+#ifndef COORDSYSTEM_DISTANCEKERNELS_H
+#define COORDSYSTEM_DISTANCEKERNELS_H
+
+#include <cstddef>
+
+#include "Coordinates/Simd/ConversionKernels.h"
+#include "Coordinates/Simd/SimdMath.h"
+
+// Vector versions of the distance functions from Coordinates/Distance.h, instantiated per
+// instruction set next to the conversion kernels in Simd/ConversionKernels*.cpp.
+namespace Coord::Simd
+{
+    struct DistanceKernels
+    {
+        // Pairwise, out[i] is the distance between the points at index i of both sets
+        void (*cartesian2D)(const double* x1, const double* y1, const double* x2, const double* y2,
+                            double* out, std::size_t count);
+        void (*cartesian3D)(const double* x1, const double* y1, const double* z1,
+                            const double* x2, const double* y2, const double* z2, double* out, std::size_t count);
+        void (*polar2D)(const double* radius1, const double* theta1, const double* radius2, const double* theta2,
+                        double* out, std::size_t count);
+        void (*chord)(const double* radius1, const double* theta1, const double* polarAngle1,
+                      const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count);
+        void (*arc)(const double* radius1, const double* theta1, const double* polarAngle1,
+                    const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count);
+
+        // One-to-many, out[i] is the distance from the point "from" (its coordinates in order) to point i
+        void (*cartesian2DFrom)(const double* from, const double* x, const double* y, double* out, std::size_t count);
+        void (*cartesian3DFrom)(const double* from, const double* x, const double* y, const double* z,
+                                double* out, std::size_t count);
+        void (*polar2DFrom)(const double* from, const double* radius, const double* theta, double* out, std::size_t count);
+        void (*chordFrom)(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                          double* out, std::size_t count);
+        void (*arcFrom)(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                        double* out, std::size_t count);
+
+        // Great-circle distance between spherical points, pairwise and one-to-many, see distance3DGreatCircle
+        // and distance3DHaversine in Distance.h
+        void (*greatCircle)(const double* radius1, const double* theta1, const double* polarAngle1,
+                            const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count);
+        void (*haversine)(const double* radius1, const double* theta1, const double* polarAngle1,
+                          const double* radius2, const double* theta2, const double* polarAngle2, double* out, std::size_t count);
+        void (*greatCircleFrom)(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                                double* out, std::size_t count);
+        void (*haversineFrom)(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                              double* out, std::size_t count);
+
+        // One-to-many over prepared spherical points (see PreparedSpherical.h): radius and unit vector columns,
+        // "from" is radius, x, y, z of the unit vector
+        void (*preparedChordFrom)(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                  double* out, std::size_t count);
+        void (*preparedArcFrom)(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                double* out, std::size_t count);
+    };
+
+    // Same availability as the conversion kernels of the instruction set
+    const DistanceKernels* getSSE42DistanceKernels();
+    const DistanceKernels* getAVX2DistanceKernels();
+    const DistanceKernels* getAVX512DistanceKernels();
+
+    // r1^2 + r2^2 - 2 r1 r2 cos, clamped at 0 so rounding can't produce the root of a negative number
+    template <typename V>
+    V lawOfCosines(const V r1, const V r2, const V cosine)
+    {
+        const V squared { mulAdd(r1, r1, r2 * r2) - V(2.0) * r1 * r2 * cosine };
+        return sqrt(max(squared, V(0.0)));
+    }
+
+    // Cosine of the angle between two directions given by azimuth and polar angle
+    template <typename V>
+    V centralCosine(const V sinPhi1, const V cosPhi1, const V theta1, const V theta2, const V polarAngle2)
+    {
+        V sinPhi2, cosPhi2, sinDelta, cosDelta;
+        sinCos(polarAngle2, sinPhi2, cosPhi2);
+        sinCos(theta1 - theta2, sinDelta, cosDelta);
+        return mulAdd(sinPhi1 * sinPhi2, cosDelta, cosPhi1 * cosPhi2);
+    }
+
+    template <typename V>
+    V arcLength(const V r1, const V r2, const V cosine)
+    {
+        return (r1 + r2) * V(0.5) * acos(min(max(cosine, V(-1.0)), V(1.0)));
+    }
+
+    // Angle between two directions from atan2 of its sine and cosine (Vincenty), precise at every separation
+    template <typename V>
+    V vincentyAngle(const V polarAngle1, const V sinPhi1, const V cosPhi1, const V theta1, const V theta2, const V polarAngle2)
+    {
+        V sinPhi2, cosPhi2, sinHalfDelta, cosHalfDelta;
+        sinCos(polarAngle2, sinPhi2, cosPhi2);
+        sinCos((theta2 - theta1) * V(0.5), sinHalfDelta, cosHalfDelta);
+
+        // 1 - cos(delta) from the half angle, see distance3DGreatCircle
+        const V versine { V(2.0) * sinHalfDelta * sinHalfDelta };
+        const V across { sinPhi2 * V(2.0) * sinHalfDelta * cosHalfDelta };
+        const V along { mulAdd(cosPhi1 * sinPhi2, versine, sin(polarAngle1 - polarAngle2)) };
+        const V cosine { mulAdd(sinPhi1 * sinPhi2, V(1.0) - versine, cosPhi1 * cosPhi2) };
+        return atan2(sqrt(mulAdd(across, across, along * along)), cosine);
+    }
+
+    // The same angle from its haversine, with the reduction-light sin() of SimdMath.h
+    template <typename V>
+    V haversineAngle(const V polarAngle1, const V sinPhi1, const V theta1, const V theta2, const V polarAngle2)
+    {
+        const V sinHalfPhi { sin((polarAngle2 - polarAngle1) * V(0.5)) };
+        const V sinHalfTheta { sin((theta2 - theta1) * V(0.5)) };
+        const V haversine { mulAdd(sinPhi1 * sin(polarAngle2), sinHalfTheta * sinHalfTheta, sinHalfPhi * sinHalfPhi) };
+        const V clamped { min(max(haversine, V(0.0)), V(1.0)) };
+        return V(2.0) * atan2(sqrt(clamped), sqrt(V(1.0) - clamped));
+    }
+
+    template <typename V>
+    void cartesian2DDistance(const double* x1, const double* y1, const double* x2, const double* y2,
+                             double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ x1, y1, x2, y2 }, { out }, count, [](const V (&in)[4], V (&result)[1])
+        {
+            const V dx { in[2] - in[0] };
+            const V dy { in[3] - in[1] };
+            result[0] = sqrt(mulAdd(dx, dx, dy * dy));
+        });
+    }
+
+    template <typename V>
+    void cartesian3DDistance(const double* x1, const double* y1, const double* z1,
+                             const double* x2, const double* y2, const double* z2, double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ x1, y1, z1, x2, y2, z2 }, { out }, count, [](const V (&in)[6], V (&result)[1])
+        {
+            const V dx { in[3] - in[0] };
+            const V dy { in[4] - in[1] };
+            const V dz { in[5] - in[2] };
+            result[0] = sqrt(mulAdd(dx, dx, mulAdd(dy, dy, dz * dz)));
+        });
+    }
+
+    template <typename V>
+    void polar2DDistance(const double* radius1, const double* theta1, const double* radius2, const double* theta2,
+                         double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ radius1, theta1, radius2, theta2 }, { out }, count, [](const V (&in)[4], V (&result)[1])
+        {
+            V sin, cos;
+            sinCos(in[3] - in[1], sin, cos);
+            result[0] = lawOfCosines(in[0], in[2], cos);
+        });
+    }
+
+    template <typename V>
+    void chordDistance(const double* radius1, const double* theta1, const double* polarAngle1,
+                       const double* radius2, const double* theta2, const double* polarAngle2, double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ radius1, theta1, polarAngle1, radius2, theta2, polarAngle2 }, { out }, count,
+                        [](const V (&in)[6], V (&result)[1])
+        {
+            V sinPhi1, cosPhi1;
+            sinCos(in[2], sinPhi1, cosPhi1);
+            result[0] = lawOfCosines(in[0], in[3], centralCosine(sinPhi1, cosPhi1, in[1], in[4], in[5]));
+        });
+    }
+
+    template <typename V>
+    void arcDistance(const double* radius1, const double* theta1, const double* polarAngle1,
+                     const double* radius2, const double* theta2, const double* polarAngle2, double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ radius1, theta1, polarAngle1, radius2, theta2, polarAngle2 }, { out }, count,
+                        [](const V (&in)[6], V (&result)[1])
+        {
+            V sinPhi1, cosPhi1;
+            sinCos(in[2], sinPhi1, cosPhi1);
+            result[0] = arcLength(in[0], in[3], centralCosine(sinPhi1, cosPhi1, in[1], in[4], in[5]));
+        });
+    }
+
+    template <typename V>
+    void cartesian2DDistanceFrom(const double* from, const double* x, const double* y, double* out, const std::size_t count)
+    {
+        const V fromX { from[0] }, fromY { from[1] };
+        forEachBlock<V>({ x, y }, { out }, count, [fromX, fromY](const V (&in)[2], V (&result)[1])
+        {
+            const V dx { in[0] - fromX };
+            const V dy { in[1] - fromY };
+            result[0] = sqrt(mulAdd(dx, dx, dy * dy));
+        });
+    }
+
+    template <typename V>
+    void cartesian3DDistanceFrom(const double* from, const double* x, const double* y, const double* z,
+                                 double* out, const std::size_t count)
+    {
+        const V fromX { from[0] }, fromY { from[1] }, fromZ { from[2] };
+        forEachBlock<V>({ x, y, z }, { out }, count, [fromX, fromY, fromZ](const V (&in)[3], V (&result)[1])
+        {
+            const V dx { in[0] - fromX };
+            const V dy { in[1] - fromY };
+            const V dz { in[2] - fromZ };
+            result[0] = sqrt(mulAdd(dx, dx, mulAdd(dy, dy, dz * dz)));
+        });
+    }
+
+    template <typename V>
+    void polar2DDistanceFrom(const double* from, const double* radius, const double* theta, double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromTheta { from[1] };
+        forEachBlock<V>({ radius, theta }, { out }, count, [fromRadius, fromTheta](const V (&in)[2], V (&result)[1])
+        {
+            V sin, cos;
+            sinCos(in[1] - fromTheta, sin, cos);
+            result[0] = lawOfCosines(fromRadius, in[0], cos);
+        });
+    }
+
+    // The trig terms of "from" are computed once per call
+    template <typename V>
+    void chordDistanceFrom(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                           double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromTheta { from[1] }, fromPolarAngle { from[2] };
+        V sinPhi1, cosPhi1;
+        sinCos(fromPolarAngle, sinPhi1, cosPhi1);
+
+        forEachBlock<V>({ radius, theta, polarAngle }, { out }, count,
+                        [=](const V (&in)[3], V (&result)[1])
+        {
+            result[0] = lawOfCosines(fromRadius, in[0], centralCosine(sinPhi1, cosPhi1, fromTheta, in[1], in[2]));
+        });
+    }
+
+    template <typename V>
+    void arcDistanceFrom(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                         double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromTheta { from[1] }, fromPolarAngle { from[2] };
+        V sinPhi1, cosPhi1;
+        sinCos(fromPolarAngle, sinPhi1, cosPhi1);
+
+        forEachBlock<V>({ radius, theta, polarAngle }, { out }, count,
+                        [=](const V (&in)[3], V (&result)[1])
+        {
+            result[0] = arcLength(fromRadius, in[0], centralCosine(sinPhi1, cosPhi1, fromTheta, in[1], in[2]));
+        });
+    }
+
+    template <typename V>
+    void greatCircleDistance(const double* radius1, const double* theta1, const double* polarAngle1,
+                             const double* radius2, const double* theta2, const double* polarAngle2, double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ radius1, theta1, polarAngle1, radius2, theta2, polarAngle2 }, { out }, count,
+                        [](const V (&in)[6], V (&result)[1])
+        {
+            V sinPhi1, cosPhi1;
+            sinCos(in[2], sinPhi1, cosPhi1);
+            result[0] = (in[0] + in[3]) * V(0.5) * vincentyAngle(in[2], sinPhi1, cosPhi1, in[1], in[4], in[5]);
+        });
+    }
+
+    template <typename V>
+    void haversineDistance(const double* radius1, const double* theta1, const double* polarAngle1,
+                           const double* radius2, const double* theta2, const double* polarAngle2, double* out, const std::size_t count)
+    {
+        forEachBlock<V>({ radius1, theta1, polarAngle1, radius2, theta2, polarAngle2 }, { out }, count,
+                        [](const V (&in)[6], V (&result)[1])
+        {
+            result[0] = (in[0] + in[3]) * V(0.5) * haversineAngle(in[2], sin(in[2]), in[1], in[4], in[5]);
+        });
+    }
+
+    template <typename V>
+    void greatCircleDistanceFrom(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                                 double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromTheta { from[1] }, fromPolarAngle { from[2] };
+        V sinPhi1, cosPhi1;
+        sinCos(fromPolarAngle, sinPhi1, cosPhi1);
+
+        forEachBlock<V>({ radius, theta, polarAngle }, { out }, count,
+                        [=](const V (&in)[3], V (&result)[1])
+        {
+            result[0] = (fromRadius + in[0]) * V(0.5) * vincentyAngle(fromPolarAngle, sinPhi1, cosPhi1, fromTheta, in[1], in[2]);
+        });
+    }
+
+    template <typename V>
+    void haversineDistanceFrom(const double* from, const double* radius, const double* theta, const double* polarAngle,
+                               double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromTheta { from[1] }, fromPolarAngle { from[2] };
+        const V sinPhi1 { sin(fromPolarAngle) };
+
+        forEachBlock<V>({ radius, theta, polarAngle }, { out }, count,
+                        [=](const V (&in)[3], V (&result)[1])
+        {
+            result[0] = (fromRadius + in[0]) * V(0.5) * haversineAngle(fromPolarAngle, sinPhi1, fromTheta, in[1], in[2]);
+        });
+    }
+
+    template <typename V>
+    void preparedChordDistanceFrom(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                   double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromX { from[1] }, fromY { from[2] }, fromZ { from[3] };
+        forEachBlock<V>({ radius, x, y, z }, { out }, count, [=](const V (&in)[4], V (&result)[1])
+        {
+            const V cosine { mulAdd(fromX, in[1], mulAdd(fromY, in[2], fromZ * in[3])) };
+            result[0] = lawOfCosines(fromRadius, in[0], cosine);
+        });
+    }
+
+    template <typename V>
+    void preparedArcDistanceFrom(const double* from, const double* radius, const double* x, const double* y, const double* z,
+                                 double* out, const std::size_t count)
+    {
+        const V fromRadius { from[0] }, fromX { from[1] }, fromY { from[2] }, fromZ { from[3] };
+        forEachBlock<V>({ radius, x, y, z }, { out }, count, [=](const V (&in)[4], V (&result)[1])
+        {
+            const V cosine { mulAdd(fromX, in[1], mulAdd(fromY, in[2], fromZ * in[3])) };
+            result[0] = arcLength(fromRadius, in[0], cosine);
+        });
+    }
+
+    template <typename V>
+    constexpr DistanceKernels makeDistanceKernels()
+    {
+        return {
+            &cartesian2DDistance<V>,
+            &cartesian3DDistance<V>,
+            &polar2DDistance<V>,
+            &chordDistance<V>,
+            &arcDistance<V>,
+            &cartesian2DDistanceFrom<V>,
+            &cartesian3DDistanceFrom<V>,
+            &polar2DDistanceFrom<V>,
+            &chordDistanceFrom<V>,
+            &arcDistanceFrom<V>,
+            &greatCircleDistance<V>,
+            &haversineDistance<V>,
+            &greatCircleDistanceFrom<V>,
+            &haversineDistanceFrom<V>,
+            &preparedChordDistanceFrom<V>,
+            &preparedArcDistanceFrom<V>
+        };
+    }
+}
+
+#endif //COORDSYSTEM_DISTANCEKERNELS_H
@@ -0,0 +1,58 @@
+#ifndef COORDSYSTEM_SCALARVEC_H
+#define COORDSYSTEM_SCALARVEC_H
+
+#include <cmath>
+#include <cstddef>
+
+// One-lane implementation of the vector interface from SimdMath.h,
+// used to evaluate the SIMD polynomials on single values.
+namespace Coord::Simd
+{
+    struct ScalarMask
+    {
+        bool v;
+
+        friend constexpr ScalarMask operator&(ScalarMask a, ScalarMask b) { return { a.v && b.v }; }
+        friend constexpr ScalarMask operator|(ScalarMask a, ScalarMask b) { return { a.v || b.v }; }
+        friend constexpr bool anyOf(ScalarMask m) { return m.v; }
+    };
+
+    template <typename T>
+    struct ScalarVec
+    {
+        using Scalar = T;
+        static constexpr std::size_t Width { 1 };
+
+        T v;
+
+        ScalarVec() = default;
+        constexpr ScalarVec(T value) : v{ value } {}
+
+        static constexpr ScalarVec load(const T* p) { return *p; }
+        constexpr void store(T* p) const { *p = v; }
+
+        friend constexpr ScalarVec operator+(ScalarVec a, ScalarVec b) { return a.v + b.v; }
+        friend constexpr ScalarVec operator-(ScalarVec a, ScalarVec b) { return a.v - b.v; }
+        friend constexpr ScalarVec operator*(ScalarVec a, ScalarVec b) { return a.v * b.v; }
+        friend constexpr ScalarVec operator/(ScalarVec a, ScalarVec b) { return a.v / b.v; }
+        friend constexpr ScalarVec operator-(ScalarVec a) { return -a.v; }
+
+        friend constexpr ScalarMask operator==(ScalarVec a, ScalarVec b) { return { a.v == b.v }; }
+        friend constexpr ScalarMask operator<(ScalarVec a, ScalarVec b) { return { a.v < b.v }; }
+        friend constexpr ScalarMask operator>(ScalarVec a, ScalarVec b) { return { a.v > b.v }; }
+        friend constexpr ScalarMask operator>=(ScalarVec a, ScalarVec b) { return { a.v >= b.v }; }
+
+        // Separate multiply and add: std::fma is a library call without hardware FMA
+        friend constexpr ScalarVec mulAdd(ScalarVec a, ScalarVec b, ScalarVec c) { return a.v * b.v + c.v; }
+        friend ScalarVec sqrt(ScalarVec a) { return std::sqrt(a.v); }
+        friend ScalarVec abs(ScalarVec a) { return std::abs(a.v); }
+        friend ScalarVec floor(ScalarVec a) { return std::floor(a.v); }
+        friend ScalarVec roundNearest(ScalarVec a) { return std::nearbyint(a.v); }
+        friend constexpr ScalarVec min(ScalarVec a, ScalarVec b) { return b.v < a.v ? b.v : a.v; }
+        friend constexpr ScalarVec max(ScalarVec a, ScalarVec b) { return a.v < b.v ? b.v : a.v; }
+        friend ScalarVec copySign(ScalarVec magnitude, ScalarVec sign) { return std::copysign(magnitude.v, sign.v); }
+        friend constexpr ScalarVec select(ScalarMask m, ScalarVec a, ScalarVec b) { return m.v ? a : b; }
+    };
+}
+
+#endif //COORDSYSTEM_SCALARVEC_H
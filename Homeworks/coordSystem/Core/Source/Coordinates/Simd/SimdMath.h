@@ -0,0 +1,236 @@
+#ifndef COORDSYSTEM_SIMDMATH_H
+#define COORDSYSTEM_SIMDMATH_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// Branch-free sin/cos/atan2 written once against a small vector interface, so the same
+// code is instantiated for every instruction set in Simd/ConversionKernels*.cpp and for
+// plain scalars (Simd/ScalarVec.h) in the Fast math policies.
+//
+// A vector type V has to provide:
+//   V::Scalar (double or float), V::Width, V(Scalar) broadcast, V::load(const Scalar*), v.store(Scalar*),
+//   + - * / and unary -, == < > >= returning a mask (& and | on masks),
+//   mulAdd(a, b, c) = a * b + c, sqrt, abs, floor, roundNearest, min, max,
+//   copySign(magnitude, sign), select(mask, ifTrue, ifFalse), anyOf(mask).
+//
+// Polynomials are the Cephes ones, in double or single precision depending on V::Scalar.
+// sinCos hands arguments above maxReducibleAngle to libm lane by lane.
+namespace Coord::Simd
+{
+    inline constexpr double kPi { 3.14159265358979323846 };
+    inline constexpr double kPiOver2 { 1.57079632679489661923 };
+    inline constexpr double kPiOver4 { 0.78539816339744830962 };
+
+    template <typename T>
+    inline constexpr bool isSinglePrecision { std::is_same_v<T, float> };
+
+    // Cody-Waite range reduction stays exact up to these arguments
+    template <typename T>
+    inline constexpr T maxReducibleAngle { isSinglePrecision<T> ? 8192.0f : 1.0e8 };
+
+    template <typename V>
+    void sinCos(const V x, V& sin, V& cos)
+    {
+        using T = typename V::Scalar;
+
+        if (anyOf(abs(x) > V(maxReducibleAngle<T>))) [[unlikely]]
+        {
+            T lanes[V::Width], sinLanes[V::Width], cosLanes[V::Width];
+            x.store(lanes);
+            for (std::size_t i = 0; i < V::Width; ++i)
+            {
+                sinLanes[i] = std::sin(lanes[i]);
+                cosLanes[i] = std::cos(lanes[i]);
+            }
+            sin = V::load(sinLanes);
+            cos = V::load(cosLanes);
+            return;
+        }
+
+        // x = quadrant * pi/2 + r, |r| <= pi/4
+        const V quadrant { roundNearest(x * V(0.63661977236758134308)) };
+        V r;
+        V sinPoly, cosPoly;
+
+        if constexpr (isSinglePrecision<T>)
+        {
+            r = mulAdd(quadrant, V(-1.5703125f), x);
+            r = mulAdd(quadrant, V(-4.837512969970703125e-4f), r);
+            r = mulAdd(quadrant, V(-7.54978995489188216e-8f), r);
+
+            const V z { r * r };
+
+            sinPoly = V(-1.9515295891E-4f);
+            sinPoly = mulAdd(sinPoly, z, V(8.3321608736E-3f));
+            sinPoly = mulAdd(sinPoly, z, V(-1.6666654611E-1f));
+            sinPoly = mulAdd(r * z, sinPoly, r);
+
+            cosPoly = V(2.443315711809948E-5f);
+            cosPoly = mulAdd(cosPoly, z, V(-1.388731625493765E-3f));
+            cosPoly = mulAdd(cosPoly, z, V(4.166664568298827E-2f));
+            cosPoly = mulAdd(z * z, cosPoly, mulAdd(z, V(-0.5f), V(1.0f)));
+        }
+        else
+        {
+            r = mulAdd(quadrant, V(-1.57079625129699707031E0), x);
+            r = mulAdd(quadrant, V(-7.54978941586159635335E-8), r);
+            r = mulAdd(quadrant, V(-5.39030285815811905290E-15), r);
+
+            const V z { r * r };
+
+            sinPoly = V(1.58962301576546568060E-10);
+            sinPoly = mulAdd(sinPoly, z, V(-2.50507477628578072866E-8));
+            sinPoly = mulAdd(sinPoly, z, V(2.75573136213857245213E-6));
+            sinPoly = mulAdd(sinPoly, z, V(-1.98412698295895385996E-4));
+            sinPoly = mulAdd(sinPoly, z, V(8.33333333332211858878E-3));
+            sinPoly = mulAdd(sinPoly, z, V(-1.66666666666666307295E-1));
+            sinPoly = mulAdd(r * z, sinPoly, r);
+
+            cosPoly = V(-1.13585365213876817300E-11);
+            cosPoly = mulAdd(cosPoly, z, V(2.08757008419747316778E-9));
+            cosPoly = mulAdd(cosPoly, z, V(-2.75573141792967388112E-7));
+            cosPoly = mulAdd(cosPoly, z, V(2.48015872888517045348E-5));
+            cosPoly = mulAdd(cosPoly, z, V(-1.38888888888730564116E-3));
+            cosPoly = mulAdd(cosPoly, z, V(4.16666666666665929218E-2));
+            cosPoly = mulAdd(z * z, cosPoly, mulAdd(z, V(-0.5), V(1.0)));
+        }
+
+        // quadrant mod 4 decides which polynomial goes where and the signs
+        const V q { quadrant - V(4.0) * floor(quadrant * V(0.25)) };
+        const auto swap { (q == V(1.0)) | (q == V(3.0)) };
+        const auto negateSin { q >= V(2.0) };
+        const auto negateCos { (q == V(1.0)) | (q == V(2.0)) };
+
+        const V s { select(swap, cosPoly, sinPoly) };
+        const V c { select(swap, sinPoly, cosPoly) };
+        sin = select(negateSin, -s, s);
+        cos = select(negateCos, -c, c);
+    }
+
+    // Taylor coefficients of sin(r) / r in powers of r^2, up to r^20. At |r| = pi/2 the first dropped
+    // term is below 2e-18, so the series is exact in double over the whole half turn
+    inline constexpr std::size_t kSinTerms { 11 };
+    inline constexpr auto kSinTaylor {
+        []
+        {
+            std::array<double, kSinTerms> coefficients{};
+            double factorial { 1.0 };
+            for (std::size_t k = 0; k < kSinTerms; ++k)
+            {
+                coefficients[k] = (k % 2 == 0 ? 1.0 : -1.0) / factorial;
+                factorial *= static_cast<double>((2 * k + 2) * (2 * k + 3));
+            }
+            return coefficients;
+        }()
+    };
+
+    /**
+     * sin alone: x = k pi + r with |r| <= pi/2 and one polynomial in r, no quadrant selects.
+     * Cheaper than sinCos when the cosine isn't needed. For |x| <= maxReducibleAngle the double version
+     * is within 3 ULP (2 where mulAdd is an FMA) and 4e-16 absolute, the float version within 2e-7
+     * absolute. Like sinCos, it loses relative accuracy on arguments a few ULP from a multiple of pi.
+     */
+    template <typename V>
+    V sin(const V x)
+    {
+        using T = typename V::Scalar;
+
+        if (anyOf(abs(x) > V(maxReducibleAngle<T>))) [[unlikely]]
+        {
+            T lanes[V::Width];
+            x.store(lanes);
+            for (std::size_t i = 0; i < V::Width; ++i)
+                lanes[i] = std::sin(lanes[i]);
+            return V::load(lanes);
+        }
+
+        // pi in three parts, twice the ones of sinCos. The leading two have enough trailing zero bits
+        // that turns times them is exact without FMA too, up to maxReducibleAngle
+        const V turns { roundNearest(x * V(T(1.0 / kPi))) };
+        V r;
+        if constexpr (isSinglePrecision<T>)
+        {
+            r = mulAdd(turns, V(-3.140625f), x);
+            r = mulAdd(turns, V(-9.67502593994140625e-4f), r);
+            r = mulAdd(turns, V(-1.509957990978376432e-7f), r);
+        }
+        else
+        {
+            r = mulAdd(turns, V(-3.14159250259399414062E0), x);
+            r = mulAdd(turns, V(-1.50995788317231927067E-7), r);
+            r = mulAdd(turns, V(-1.07806057163162381058E-14), r);
+        }
+
+        const V z { r * r };
+        V poly { V(T(kSinTaylor[kSinTerms - 1])) };
+        for (std::size_t k = kSinTerms - 1; k-- > 0;)
+            poly = mulAdd(poly, z, V(T(kSinTaylor[k])));
+
+        // sin(k pi + r) = (-1)^k sin(r)
+        const V odd { turns - V(2.0) * floor(turns * V(0.5)) };
+        return (r * poly) * mulAdd(odd, V(-2.0), V(1.0));
+    }
+
+    // atan(t) for |t| <= tan(pi/8)
+    template <typename V>
+    V atanReduced(const V t)
+    {
+        const V z { t * t };
+
+        if constexpr (isSinglePrecision<typename V::Scalar>)
+        {
+            V p { V(8.05374449538e-2f) };
+            p = mulAdd(p, z, V(-1.38776856032E-1f));
+            p = mulAdd(p, z, V(1.99777106478E-1f));
+            p = mulAdd(p, z, V(-3.33329491539E-1f));
+            return mulAdd(t * z, p, t);
+        }
+        else
+        {
+            V p { V(-8.750608600031904122785E-1) };
+            p = mulAdd(p, z, V(-1.615753718733365076637E1));
+            p = mulAdd(p, z, V(-7.500855792314704667340E1));
+            p = mulAdd(p, z, V(-1.228866684490136173410E2));
+            p = mulAdd(p, z, V(-6.485021904942025371773E1));
+
+            V q { z + V(2.485846490142306297962E1) };
+            q = mulAdd(q, z, V(1.650270098316988542046E2));
+            q = mulAdd(q, z, V(4.328810604912902668951E2));
+            q = mulAdd(q, z, V(4.853903996359136964868E2));
+            q = mulAdd(q, z, V(1.945506571482613964425E2));
+
+            return mulAdd(t * z, p / q, t);
+        }
+    }
+
+    template <typename V>
+    V atan2(const V y, const V x)
+    {
+        const V ax { abs(x) };
+        const V ay { abs(y) };
+        const V largest { max(ax, ay) };
+        const V ratio { select(largest == V(0.0), V(0.0), min(ax, ay) / largest) };
+
+        // atan(a) = pi/4 + atan((a - 1) / (a + 1)) keeps the polynomial argument small
+        const auto aboveTanPi8 { ratio > V(0.41421356237309504880) };
+        const V t { select(aboveTanPi8, (ratio - V(1.0)) / (ratio + V(1.0)), ratio) };
+        V angle { atanReduced(t) };
+        angle = select(aboveTanPi8, angle + V(kPiOver4), angle);
+
+        angle = select(ay > ax, V(kPiOver2) - angle, angle);
+        angle = select(copySign(V(1.0), x) < V(0.0), V(kPi) - angle, angle);
+        return copySign(angle, y);
+    }
+
+    // acos(x) = atan2(sqrt(1 - x^2), x), written so it doesn't cancel near |x| = 1
+    template <typename V>
+    V acos(const V x)
+    {
+        return atan2(sqrt((V(1.0) - x) * (V(1.0) + x)), x);
+    }
+}
+
+#endif //COORDSYSTEM_SIMDMATH_H
@@ -0,0 +1,123 @@
+#ifndef COORDSYSTEM_TRANSFORMKERNELS_H
+#define COORDSYSTEM_TRANSFORMKERNELS_H
+
+#include <cstddef>
+
+#include "Coordinates/Simd/ConversionKernels.h"
+#include "Coordinates/Simd/SimdMath.h"
+
+// Vector versions of Affine2D/Affine3D from Coordinates/Transform.h, instantiated per instruction
+// set next to the conversion kernels in Simd/ConversionKernels*.cpp.
+namespace Coord::Simd
+{
+    struct TransformKernels
+    {
+        // matrix is Affine2D::matrix / Affine3D::matrix. Output may be the input columns
+        void (*affine2D)(const double* matrix, const double* x, const double* y, double* outX, double* outY, std::size_t count);
+        void (*affine3D)(const double* matrix, const double* x, const double* y, const double* z,
+                         double* outX, double* outY, double* outZ, std::size_t count);
+
+        // Local polar/spherical points to Cartesian and through the transform in one pass
+        void (*polarAffine2D)(const double* matrix, const double* radius, const double* theta,
+                              double* outX, double* outY, std::size_t count);
+        void (*sphericalAffine3D)(const double* matrix, const double* radius, const double* theta, const double* polarAngle,
+                                  double* outX, double* outY, double* outZ, std::size_t count);
+    };
+
+    // Same availability as the conversion kernels of the instruction set
+    const TransformKernels* getSSE42TransformKernels();
+    const TransformKernels* getAVX2TransformKernels();
+    const TransformKernels* getAVX512TransformKernels();
+
+    // The matrix elements broadcast once per call
+    template <typename V, std::size_t N>
+    struct BroadcastMatrix
+    {
+        explicit BroadcastMatrix(const double* matrix)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                m[i] = V(matrix[i]);
+        }
+
+        V m[N];
+    };
+
+    template <typename V>
+    void applyAffine2D(const BroadcastMatrix<V, 6>& a, const V x, const V y, V (&out)[2])
+    {
+        out[0] = mulAdd(a.m[0], x, mulAdd(a.m[1], y, a.m[2]));
+        out[1] = mulAdd(a.m[3], x, mulAdd(a.m[4], y, a.m[5]));
+    }
+
+    template <typename V>
+    void applyAffine3D(const BroadcastMatrix<V, 12>& a, const V x, const V y, const V z, V (&out)[3])
+    {
+        out[0] = mulAdd(a.m[0], x, mulAdd(a.m[1], y, mulAdd(a.m[2], z, a.m[3])));
+        out[1] = mulAdd(a.m[4], x, mulAdd(a.m[5], y, mulAdd(a.m[6], z, a.m[7])));
+        out[2] = mulAdd(a.m[8], x, mulAdd(a.m[9], y, mulAdd(a.m[10], z, a.m[11])));
+    }
+
+    template <typename V>
+    void affine2DTransform(const double* matrix, const double* x, const double* y, double* outX, double* outY,
+                           const std::size_t count)
+    {
+        const BroadcastMatrix<V, 6> a { matrix };
+        forEachBlock<V>({ x, y }, { outX, outY }, count, [&a](const V (&in)[2], V (&out)[2])
+        {
+            applyAffine2D(a, in[0], in[1], out);
+        });
+    }
+
+    template <typename V>
+    void affine3DTransform(const double* matrix, const double* x, const double* y, const double* z,
+                           double* outX, double* outY, double* outZ, const std::size_t count)
+    {
+        const BroadcastMatrix<V, 12> a { matrix };
+        forEachBlock<V>({ x, y, z }, { outX, outY, outZ }, count, [&a](const V (&in)[3], V (&out)[3])
+        {
+            applyAffine3D(a, in[0], in[1], in[2], out);
+        });
+    }
+
+    template <typename V>
+    void polarAffine2DTransform(const double* matrix, const double* radius, const double* theta,
+                                double* outX, double* outY, const std::size_t count)
+    {
+        const BroadcastMatrix<V, 6> a { matrix };
+        forEachBlock<V>({ radius, theta }, { outX, outY }, count, [&a](const V (&in)[2], V (&out)[2])
+        {
+            V sin, cos;
+            sinCos(in[1], sin, cos);
+            applyAffine2D(a, in[0] * cos, in[0] * sin, out);
+        });
+    }
+
+    template <typename V>
+    void sphericalAffine3DTransform(const double* matrix, const double* radius, const double* theta, const double* polarAngle,
+                                    double* outX, double* outY, double* outZ, const std::size_t count)
+    {
+        const BroadcastMatrix<V, 12> a { matrix };
+        forEachBlock<V>({ radius, theta, polarAngle }, { outX, outY, outZ }, count, [&a](const V (&in)[3], V (&out)[3])
+        {
+            V sinTheta, cosTheta, sinPhi, cosPhi;
+            sinCos(in[1], sinTheta, cosTheta);
+            sinCos(in[2], sinPhi, cosPhi);
+
+            const V planar { in[0] * sinPhi };
+            applyAffine3D(a, planar * cosTheta, planar * sinTheta, in[0] * cosPhi, out);
+        });
+    }
+
+    template <typename V>
+    constexpr TransformKernels makeTransformKernels()
+    {
+        return {
+            &affine2DTransform<V>,
+            &affine3DTransform<V>,
+            &polarAffine2DTransform<V>,
+            &sphericalAffine3DTransform<V>
+        };
+    }
+}
+
+#endif //COORDSYSTEM_TRANSFORMKERNELS_H
@@ -0,0 +1,683 @@
+#ifndef COORDSYSTEM_SPATIALINDEX_H
+#define COORDSYSTEM_SPATIALINDEX_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "CoordinateSystems.h"
+
+// Spatial indices over Cartesian points for nearest neighbour, radius and box queries.
+// KdTree is built once from a fixed set of points and answers queries in O(log n).
+// UniformGrid hashes points into square (cubic) cells and inserts, moves and removes them in O(1),
+// which suits data that changes every frame. Its queries only look at the cells around the query.
+namespace Coord
+{
+    template <typename Point>
+    struct SpatialTraits;
+
+    template <typename T>
+    struct SpatialTraits<CartesianPoint2D<T>>
+    {
+        using Scalar = T;
+        static constexpr std::size_t kDimensions { 2 };
+
+        static constexpr T get(const CartesianPoint2D<T>& p, const std::size_t axis) { return axis == 0 ? p.x : p.y; }
+    };
+
+    template <typename T>
+    struct SpatialTraits<CartesianPoint3D<T>>
+    {
+        using Scalar = T;
+        static constexpr std::size_t kDimensions { 3 };
+
+        static constexpr T get(const CartesianPoint3D<T>& p, const std::size_t axis) { return axis == 0 ? p.x : axis == 1 ? p.y : p.z; }
+    };
+
+    template <typename Point>
+    concept SpatialPoint = requires { SpatialTraits<Point>::kDimensions; };
+
+    template <typename T>
+    struct Neighbor
+    {
+        // Position of the point in the built set (KdTree) or its handle (UniformGrid)
+        std::size_t index;
+        T distance;
+    };
+
+    namespace Detail
+    {
+        template <typename Point>
+        using SpatialScalar = typename SpatialTraits<Point>::Scalar;
+
+        template <typename Point>
+        constexpr SpatialScalar<Point> coordinate(const Point& p, const std::size_t axis) { return SpatialTraits<Point>::get(p, axis); }
+
+        template <typename Point>
+        bool isFinite(const Point& p)
+        {
+            for (std::size_t axis = 0; axis < SpatialTraits<Point>::kDimensions; ++axis)
+                if (!std::isfinite(coordinate(p, axis)))
+                    return false;
+            return true;
+        }
+
+        template <typename Point>
+        bool hasNaN(const Point& p)
+        {
+            for (std::size_t axis = 0; axis < SpatialTraits<Point>::kDimensions; ++axis)
+                if (std::isnan(coordinate(p, axis)))
+                    return true;
+            return false;
+        }
+
+        template <typename Point>
+        constexpr bool insideBox(const Point& p, const Point& min, const Point& max)
+        {
+            for (std::size_t axis = 0; axis < SpatialTraits<Point>::kDimensions; ++axis)
+            {
+                const auto value { coordinate(p, axis) };
+                if (value < coordinate(min, axis) || value > coordinate(max, axis))
+                    return false;
+            }
+            return true;
+        }
+
+        // The k closest candidates so far, a max-heap on the squared distance
+        template <typename T>
+        class NearestHeap
+        {
+        public:
+            NearestHeap(std::vector<Neighbor<T>>& items, const std::size_t k, const T maxSquaredDistance)
+                : m_items{ items }, m_k{ k }, m_bound{ maxSquaredDistance }
+            {
+                m_items.clear();
+            }
+
+            void offer(const std::size_t index, const T squaredDistance)
+            {
+                if (m_k == 0 || squaredDistance > m_bound)
+                    return;
+
+                if (m_items.size() == m_k)
+                {
+                    std::ranges::pop_heap(m_items, {}, &Neighbor<T>::distance);
+                    m_items.pop_back();
+                }
+                m_items.push_back({ index, squaredDistance });
+                std::ranges::push_heap(m_items, {}, &Neighbor<T>::distance);
+
+                if (m_items.size() == m_k)
+                    m_bound = m_items.front().distance;
+            }
+
+            // Squared distance a candidate has to beat
+            [[nodiscard]] T bound() const { return m_bound; }
+
+            // Sorts the result nearest first and turns squared distances into distances
+            void finish()
+            {
+                std::ranges::sort_heap(m_items, {}, &Neighbor<T>::distance);
+                for (Neighbor<T>& n : m_items)
+                    n.distance = std::sqrt(n.distance);
+            }
+        private:
+            std::vector<Neighbor<T>>& m_items;
+            std::size_t m_k;
+            T m_bound;
+        };
+
+        template <typename T>
+        constexpr T squaredLimit(const T distance)
+        {
+            return distance == std::numeric_limits<T>::infinity() ? distance : distance * distance;
+        }
+    }
+
+    /**
+     * Balanced k-d tree over a fixed point set. The points are stored in tree order, so a query walks
+     * contiguous memory, and small subtrees are scanned linearly instead of split further.
+     * Points with a NaN or infinite coordinate are left out of the tree, no query finds them and size()
+     * doesn't count them. Queries with a NaN in them find nothing.
+     */
+    template <SpatialPoint Point>
+    class KdTree
+    {
+    public:
+        using Scalar = Detail::SpatialScalar<Point>;
+        static constexpr std::size_t kDimensions { SpatialTraits<Point>::kDimensions };
+
+        KdTree() = default;
+        explicit KdTree(std::span<const Point> points) { build(points); }
+
+        // Rebuilds the tree in O(n log n). Query results refer to positions in points
+        void build(std::span<const Point> points)
+        {
+            // NaN breaks the ordering the splits sort by
+            std::vector<std::size_t> order;
+            order.reserve(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+                if (Detail::isFinite(points[i]))
+                    order.push_back(i);
+
+            m_axes.assign(order.size(), 0);
+            buildRange(points, order, 0, order.size());
+
+            m_points.resize(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                m_points[i] = points[order[i]];
+            m_indices = std::move(order);
+        }
+
+        [[nodiscard]] std::size_t size() const { return m_points.size(); }
+        [[nodiscard]] bool empty() const { return m_points.empty(); }
+
+        [[nodiscard]] std::optional<Neighbor<Scalar>> nearest(const Point& query,
+                                                              const Scalar maxDistance = std::numeric_limits<Scalar>::infinity()) const
+        {
+            std::vector<Neighbor<Scalar>> result;
+            nearest(query, 1, result, maxDistance);
+            return result.empty() ? std::nullopt : std::optional{ result.front() };
+        }
+
+        // out is replaced by the up to k closest points not farther than maxDistance, nearest first
+        void nearest(const Point& query, const std::size_t k, std::vector<Neighbor<Scalar>>& out,
+                     const Scalar maxDistance = std::numeric_limits<Scalar>::infinity()) const
+        {
+            Detail::NearestHeap<Scalar> heap(out, k, Detail::squaredLimit(maxDistance));
+            if (k > 0 && Detail::isFinite(query))
+                searchNearest(query, heap, 0, m_points.size());
+            heap.finish();
+        }
+
+        // out is replaced by the points closer than radius, in no particular order
+        void withinRadius(const Point& query, const Scalar radius, std::vector<std::size_t>& out) const
+        {
+            out.clear();
+            if (Detail::isFinite(query) && !std::isnan(radius))
+                searchRadius(query, radius, radius * radius, out, 0, m_points.size());
+        }
+
+        // out is replaced by the points inside [min, max] on every axis, in no particular order.
+        // Infinite bounds leave an axis open
+        void withinBox(const Point& min, const Point& max, std::vector<std::size_t>& out) const
+        {
+            out.clear();
+            if (!Detail::hasNaN(min) && !Detail::hasNaN(max))
+                searchBox(min, max, out, 0, m_points.size());
+        }
+    private:
+        static constexpr std::size_t kLeafSize { 8 };
+
+        void buildRange(std::span<const Point> points, std::vector<std::size_t>& order, const std::size_t begin, const std::size_t end)
+        {
+            if (end - begin <= kLeafSize)
+                return;
+
+            // Split along the widest extent, which keeps the cells close to square for clustered data
+            std::size_t axis { 0 };
+            Scalar widest { -1 };
+            for (std::size_t a = 0; a < kDimensions; ++a)
+            {
+                const auto [low, high] { std::ranges::minmax(std::span(order).subspan(begin, end - begin), {},
+                                                             [&](const std::size_t i) { return Detail::coordinate(points[i], a); }) };
+                const Scalar extent { Detail::coordinate(points[high], a) - Detail::coordinate(points[low], a) };
+                if (extent > widest)
+                {
+                    widest = extent;
+                    axis = a;
+                }
+            }
+
+            const std::size_t middle { begin + (end - begin) / 2 };
+            std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                             [&](const std::size_t a, const std::size_t b)
+                             {
+                                 return Detail::coordinate(points[a], axis) < Detail::coordinate(points[b], axis);
+                             });
+            m_axes[middle] = static_cast<std::uint8_t>(axis);
+
+            buildRange(points, order, begin, middle);
+            buildRange(points, order, middle + 1, end);
+        }
+
+        void searchNearest(const Point& query, Detail::NearestHeap<Scalar>& heap, const std::size_t begin, const std::size_t end) const
+        {
+            if (end - begin <= kLeafSize)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    heap.offer(m_indices[i], squaredNorm(m_points[i] - query));
+                return;
+            }
+
+            const std::size_t middle { begin + (end - begin) / 2 };
+            heap.offer(m_indices[middle], squaredNorm(m_points[middle] - query));
+
+            const std::size_t axis { m_axes[middle] };
+            const Scalar offset { Detail::coordinate(query, axis) - Detail::coordinate(m_points[middle], axis) };
+            if (offset < 0)
+            {
+                searchNearest(query, heap, begin, middle);
+                if (offset * offset <= heap.bound())
+                    searchNearest(query, heap, middle + 1, end);
+            }
+            else
+            {
+                searchNearest(query, heap, middle + 1, end);
+                if (offset * offset <= heap.bound())
+                    searchNearest(query, heap, begin, middle);
+            }
+        }
+
+        void searchRadius(const Point& query, const Scalar radius, const Scalar squaredRadius, std::vector<std::size_t>& out,
+                          const std::size_t begin, const std::size_t end) const
+        {
+            if (end - begin <= kLeafSize)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    if (squaredNorm(m_points[i] - query) < squaredRadius)
+                        out.push_back(m_indices[i]);
+                return;
+            }
+
+            const std::size_t middle { begin + (end - begin) / 2 };
+            if (squaredNorm(m_points[middle] - query) < squaredRadius)
+                out.push_back(m_indices[middle]);
+
+            const std::size_t axis { m_axes[middle] };
+            const Scalar split { Detail::coordinate(m_points[middle], axis) };
+            const Scalar value { Detail::coordinate(query, axis) };
+            if (value - radius < split)
+                searchRadius(query, radius, squaredRadius, out, begin, middle);
+            if (value + radius > split)
+                searchRadius(query, radius, squaredRadius, out, middle + 1, end);
+        }
+
+        void searchBox(const Point& min, const Point& max, std::vector<std::size_t>& out, const std::size_t begin, const std::size_t end) const
+        {
+            if (end - begin <= kLeafSize)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    if (Detail::insideBox(m_points[i], min, max))
+                        out.push_back(m_indices[i]);
+                return;
+            }
+
+            const std::size_t middle { begin + (end - begin) / 2 };
+            if (Detail::insideBox(m_points[middle], min, max))
+                out.push_back(m_indices[middle]);
+
+            const std::size_t axis { m_axes[middle] };
+            const Scalar split { Detail::coordinate(m_points[middle], axis) };
+            if (Detail::coordinate(min, axis) <= split)
+                searchBox(min, max, out, begin, middle);
+            if (Detail::coordinate(max, axis) >= split)
+                searchBox(min, max, out, middle + 1, end);
+        }
+    private:
+        std::vector<Point> m_points;
+        // Position in the built set and split axis of every tree node
+        std::vector<std::size_t> m_indices;
+        std::vector<std::uint8_t> m_axes;
+    };
+
+    /**
+     * Hash grid of equally sized cells for points that move, appear and disappear.
+     * A cell size near the usual query radius keeps queries to a handful of cells.
+     * Points with a NaN or infinite coordinate have no cell. They are kept under their handle but no query
+     * finds them, and a debug build asserts on them. Queries with a NaN in them find nothing.
+     */
+    template <SpatialPoint Point>
+    class UniformGrid
+    {
+    public:
+        using Scalar = Detail::SpatialScalar<Point>;
+        static constexpr std::size_t kDimensions { SpatialTraits<Point>::kDimensions };
+
+        explicit UniformGrid(const Scalar cellSize = 1) : m_cellSize{ cellSize }
+        {
+            assert(cellSize > 0);
+        }
+
+        /**
+         * @return Handle of the point, valid until the point is removed. Handles of removed points are reused
+         */
+        std::size_t insert(const Point& p)
+        {
+            assert(Detail::isFinite(p));
+            const bool indexed { Detail::isFinite(p) };
+            const Slot slot { p, indexed ? cellOf(p) : Cell{}, true, indexed };
+
+            std::size_t handle;
+            if (m_free.empty())
+            {
+                handle = m_slots.size();
+                m_slots.push_back(slot);
+            }
+            else
+            {
+                handle = m_free.back();
+                m_free.pop_back();
+                m_slots[handle] = slot;
+            }
+
+            if (indexed)
+                link(handle, slot.cell);
+            ++m_size;
+            return handle;
+        }
+
+        // Moves a point, it only changes cells when it crosses a cell border
+        void update(const std::size_t handle, const Point& p)
+        {
+            assert(contains(handle));
+            assert(Detail::isFinite(p));
+            Slot& slot { m_slots[handle] };
+            const bool indexed { Detail::isFinite(p) };
+            const Cell cell { indexed ? cellOf(p) : Cell{} };
+            if (indexed != slot.indexed || cell != slot.cell)
+            {
+                if (slot.indexed)
+                    unlink(handle, slot.cell);
+                if (indexed)
+                    link(handle, cell);
+                slot.cell = cell;
+                slot.indexed = indexed;
+            }
+            slot.point = p;
+        }
+
+        void remove(const std::size_t handle)
+        {
+            assert(contains(handle));
+            if (m_slots[handle].indexed)
+                unlink(handle, m_slots[handle].cell);
+            m_slots[handle].alive = false;
+            m_free.push_back(handle);
+            --m_size;
+        }
+
+        // Handles start at 0 again
+        void clear()
+        {
+            m_slots.clear();
+            m_free.clear();
+            m_cells.clear();
+            m_size = 0;
+            m_lowestCell.fill(std::numeric_limits<std::int64_t>::max());
+            m_highestCell.fill(std::numeric_limits<std::int64_t>::min());
+        }
+
+        [[nodiscard]] bool contains(const std::size_t handle) const { return handle < m_slots.size() && m_slots[handle].alive; }
+        [[nodiscard]] const Point& operator[](const std::size_t handle) const { assert(contains(handle)); return m_slots[handle].point; }
+
+        [[nodiscard]] std::size_t size() const { return m_size; }
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+        [[nodiscard]] Scalar cellSize() const { return m_cellSize; }
+
+        [[nodiscard]] std::optional<Neighbor<Scalar>> nearest(const Point& query,
+                                                              const Scalar maxDistance = std::numeric_limits<Scalar>::infinity()) const
+        {
+            std::vector<Neighbor<Scalar>> result;
+            nearest(query, 1, result, maxDistance);
+            return result.empty() ? std::nullopt : std::optional{ result.front() };
+        }
+
+        // out is replaced by the up to k closest points not farther than maxDistance, nearest first
+        void nearest(const Point& query, const std::size_t k, std::vector<Neighbor<Scalar>>& out,
+                     const Scalar maxDistance = std::numeric_limits<Scalar>::infinity()) const
+        {
+            Detail::NearestHeap<Scalar> heap(out, k, Detail::squaredLimit(maxDistance));
+            if (k > 0 && !m_cells.empty() && Detail::isFinite(query))
+                searchNearest(query, heap);
+            heap.finish();
+        }
+
+        // out is replaced by the handles of the points closer than radius, in no particular order
+        void withinRadius(const Point& query, const Scalar radius, std::vector<std::size_t>& out) const
+        {
+            out.clear();
+            if (!Detail::isFinite(query) || std::isnan(radius))
+                return;
+
+            Cell low, high;
+            for (std::size_t axis = 0; axis < kDimensions; ++axis)
+            {
+                low[axis] = cellCoordinate(Detail::coordinate(query, axis) - radius);
+                high[axis] = cellCoordinate(Detail::coordinate(query, axis) + radius);
+            }
+
+            const Scalar squaredRadius { radius * radius };
+            forEachInCells(low, high, [&](const std::size_t handle)
+            {
+                if (squaredNorm(m_slots[handle].point - query) < squaredRadius)
+                    out.push_back(handle);
+            });
+        }
+
+        // out is replaced by the handles of the points inside [min, max] on every axis, in no particular order.
+        // Infinite bounds leave an axis open
+        void withinBox(const Point& min, const Point& max, std::vector<std::size_t>& out) const
+        {
+            out.clear();
+            if (Detail::hasNaN(min) || Detail::hasNaN(max))
+                return;
+
+            forEachInCells(cellOf(min), cellOf(max), [&](const std::size_t handle)
+            {
+                if (Detail::insideBox(m_slots[handle].point, min, max))
+                    out.push_back(handle);
+            });
+        }
+    private:
+        using Cell = std::array<std::int64_t, kDimensions>;
+
+        struct CellHash
+        {
+            std::size_t operator()(const Cell& cell) const
+            {
+                std::size_t hash { 0 };
+                for (const std::int64_t c : cell)
+                    hash ^= std::hash<std::int64_t>{}(c) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+                return hash;
+            }
+        };
+
+        struct Slot
+        {
+            Point point;
+            Cell cell;
+            bool alive;
+            // Linked into m_cells, false while the point isn't finite
+            bool indexed;
+        };
+
+        // Cells are clamped to +-2^60, so the differences between cells and the ring bounds can't overflow
+        static constexpr Scalar kCellLimit { static_cast<Scalar>(std::int64_t{ 1 } << 60) };
+
+        [[nodiscard]] std::int64_t cellCoordinate(const Scalar value) const
+        {
+            assert(!std::isnan(value));
+            return static_cast<std::int64_t>(std::clamp(std::floor(value / m_cellSize), -kCellLimit, kCellLimit));
+        }
+
+        [[nodiscard]] Cell cellOf(const Point& p) const
+        {
+            Cell cell;
+            for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                cell[axis] = cellCoordinate(Detail::coordinate(p, axis));
+            return cell;
+        }
+
+        void link(const std::size_t handle, const Cell& cell)
+        {
+            m_cells[cell].push_back(handle);
+            for (std::size_t axis = 0; axis < kDimensions; ++axis)
+            {
+                m_lowestCell[axis] = std::min(m_lowestCell[axis], cell[axis]);
+                m_highestCell[axis] = std::max(m_highestCell[axis], cell[axis]);
+            }
+        }
+
+        void unlink(const std::size_t handle, const Cell& cell)
+        {
+            const auto it { m_cells.find(cell) };
+            assert(it != m_cells.end());
+            std::vector<std::size_t>& handles { it->second };
+            const auto position { std::ranges::find(handles, handle) };
+            *position = handles.back();
+            handles.pop_back();
+            if (handles.empty())
+                m_cells.erase(it);
+        }
+
+        // Calls visit(handle) for every point in the cells [low, high]
+        template <typename Visit>
+        void forEachInCells(const Cell& low, const Cell& high, Visit visit) const
+        {
+            double cellCount { 1.0 };
+            for (std::size_t axis = 0; axis < kDimensions; ++axis)
+            {
+                if (high[axis] < low[axis])
+                    return;
+                cellCount *= static_cast<double>(high[axis] - low[axis]) + 1.0;
+            }
+
+            // A range of more cells than are occupied is cheaper to answer from the occupied ones
+            if (cellCount > static_cast<double>(m_cells.size()))
+            {
+                for (const auto& [cell, handles] : m_cells)
+                {
+                    bool inside { true };
+                    for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                        inside = inside && cell[axis] >= low[axis] && cell[axis] <= high[axis];
+                    if (inside)
+                        for (const std::size_t handle : handles)
+                            visit(handle);
+                }
+                return;
+            }
+
+            Cell cell { low };
+            while (true)
+            {
+                if (const auto it { m_cells.find(cell) }; it != m_cells.end())
+                    for (const std::size_t handle : it->second)
+                        visit(handle);
+
+                std::size_t axis { 0 };
+                for (; axis < kDimensions; ++axis)
+                {
+                    if (cell[axis] < high[axis])
+                    {
+                        ++cell[axis];
+                        break;
+                    }
+                    cell[axis] = low[axis];
+                }
+                if (axis == kDimensions)
+                    return;
+            }
+        }
+
+        void searchNearest(const Point& query, Detail::NearestHeap<Scalar>& heap) const
+        {
+            const Cell center { cellOf(query) };
+
+            // Rings beyond the occupied cells are empty
+            std::int64_t lastRing { 0 };
+            for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                lastRing = std::max({ lastRing, center[axis] - m_lowestCell[axis], m_highestCell[axis] - center[axis] });
+
+            auto offerAll = [&](const std::vector<std::size_t>& handles)
+            {
+                for (const std::size_t handle : handles)
+                    heap.offer(handle, squaredNorm(m_slots[handle].point - query));
+            };
+
+            // Cells of ring r are r cells away from the center on at least one axis,
+            // so every point beyond ring r - 1 is more than (r - 1) cell sizes away
+            for (std::int64_t ring = 0; ring <= lastRing; ++ring)
+            {
+                const Scalar reached { static_cast<Scalar>(std::max(ring - 1, std::int64_t{ 0 })) * m_cellSize };
+                if (ring > 0 && reached * reached >= heap.bound())
+                    return;
+
+                double ringCells { 1.0 };
+                for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                    ringCells *= 2.0 * static_cast<double>(ring) + 1.0;
+                if (ringCells > static_cast<double>(m_cells.size()))
+                {
+                    // Scanning the occupied cells is cheaper than walking the remaining rings
+                    for (const auto& [cell, handles] : m_cells)
+                    {
+                        std::int64_t distance { 0 };
+                        for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                            distance = std::max(distance, std::abs(cell[axis] - center[axis]));
+                        if (distance >= ring)
+                            offerAll(handles);
+                    }
+                    return;
+                }
+
+                Cell low, high;
+                for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                {
+                    low[axis] = center[axis] - ring;
+                    high[axis] = center[axis] + ring;
+                }
+
+                Cell cell { low };
+                while (true)
+                {
+                    bool onRing { false };
+                    for (std::size_t axis = 0; axis < kDimensions; ++axis)
+                        onRing = onRing || cell[axis] == low[axis] || cell[axis] == high[axis];
+                    if (onRing)
+                        if (const auto it { m_cells.find(cell) }; it != m_cells.end())
+                            offerAll(it->second);
+
+                    std::size_t axis { 0 };
+                    for (; axis < kDimensions; ++axis)
+                    {
+                        if (cell[axis] < high[axis])
+                        {
+                            ++cell[axis];
+                            break;
+                        }
+                        cell[axis] = low[axis];
+                    }
+                    if (axis == kDimensions)
+                        break;
+                }
+            }
+        }
+    private:
+        Scalar m_cellSize;
+        std::vector<Slot> m_slots;
+        std::vector<std::size_t> m_free;
+        std::size_t m_size{ 0 };
+        std::unordered_map<Cell, std::vector<std::size_t>, CellHash> m_cells;
+        // Bounds of every cell that was ever occupied since the last clear(), so rings can stop early
+        Cell m_lowestCell { filled(std::numeric_limits<std::int64_t>::max()) };
+        Cell m_highestCell { filled(std::numeric_limits<std::int64_t>::min()) };
+
+        static constexpr Cell filled(const std::int64_t value)
+        {
+            Cell cell;
+            cell.fill(value);
+            return cell;
+        }
+    };
+}
+
+#endif //COORDSYSTEM_SPATIALINDEX_H
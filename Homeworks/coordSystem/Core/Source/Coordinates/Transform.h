@@ -0,0 +1,290 @@
+#ifndef COORDSYSTEM_TRANSFORM_H
+#define COORDSYSTEM_TRANSFORM_H
+
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/MathPolicy.h"
+
+// Rigid and affine frame transforms, e.g. the pose of a sensor in the world frame. A transform is
+// stored as its row-major matrix [linear | translation], which is also what the batch kernels of
+// BatchTransforms.h take, so a chain of transforms is composed once and applied as one matrix.
+namespace Coord
+{
+    /**
+     * Rotation as a unit quaternion w + xi + yj + zk. Composes without the drift of multiplied
+     * matrices and converts to one with Affine3D::rotation.
+     */
+    template <typename T = double>
+    struct Quaternion
+    {
+        /**
+         * @param axis Rotation axis, doesn't have to be normalized but must not be zero
+         * @param angle Counterclockwise looking down the axis, in radians
+         */
+        template <typename Math = ExactMath>
+        static constexpr Quaternion fromAxisAngle(const CartesianPoint3D<T>& axis, const T angle)
+        {
+            using Real = typename Math::Real;
+            Real sin, cos;
+            Math::sinCos(static_cast<Real>(angle) / 2, sin, cos);
+
+            const CartesianPoint3D<T> v { axis * (static_cast<T>(sin) / std::sqrt(squaredNorm(axis))) };
+            return { static_cast<T>(cos), v.x, v.y, v.z };
+        }
+
+        /**
+         * Yaw about z, then pitch about the new y, then roll about the new x, the usual mount angles of a sensor
+         */
+        template <typename Math = ExactMath>
+        static constexpr Quaternion fromYawPitchRoll(const T yaw, const T pitch, const T roll)
+        {
+            return fromAxisAngle<Math>({ 0, 0, 1 }, yaw) * fromAxisAngle<Math>({ 0, 1, 0 }, pitch)
+                 * fromAxisAngle<Math>({ 1, 0, 0 }, roll);
+        }
+
+        // a * b rotates by b first
+        friend constexpr Quaternion operator*(const Quaternion& a, const Quaternion& b)
+        {
+            return { a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                     a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                     a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                     a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w };
+        }
+
+        friend constexpr bool operator==(const Quaternion&, const Quaternion&) = default;
+
+        // The inverse rotation of a unit quaternion
+        [[nodiscard]] constexpr Quaternion conjugate() const { return { w, -x, -y, -z }; }
+
+        [[nodiscard]] constexpr T norm() const { return std::sqrt(w * w + x * x + y * y + z * z); }
+
+        // Composing many rotations slowly drifts off unit length
+        [[nodiscard]] constexpr Quaternion normalized() const
+        {
+            const T length { norm() };
+            return { w / length, x / length, y / length, z / length };
+        }
+
+        [[nodiscard]] constexpr CartesianPoint3D<T> rotate(const CartesianPoint3D<T>& p) const
+        {
+            // p + 2w (v x p) + 2 v x (v x p)
+            const CartesianPoint3D<T> v { x, y, z };
+            const CartesianPoint3D<T> t { cross(v, p) * T(2) };
+            return p + t * w + cross(v, t);
+        }
+
+        T w{ 1 }, x{}, y{}, z{};
+    };
+
+    template <typename T = double>
+    struct Affine2D
+    {
+        static constexpr Affine2D identity() { return {}; }
+
+        // Counterclockwise by angle radians about the origin
+        template <typename Math = ExactMath>
+        static constexpr Affine2D rotation(const T angle)
+        {
+            using Real = typename Math::Real;
+            Real sin, cos;
+            Math::sinCos(static_cast<Real>(angle), sin, cos);
+
+            const T s { static_cast<T>(sin) }, c { static_cast<T>(cos) };
+            return { { c, -s, 0,
+                       s, c, 0 } };
+        }
+
+        static constexpr Affine2D translation(const CartesianPoint2D<T>& offset)
+        {
+            return { { 1, 0, offset.x,
+                       0, 1, offset.y } };
+        }
+
+        static constexpr Affine2D scaling(const T sx, const T sy)
+        {
+            return { { sx, 0, 0,
+                       0, sy, 0 } };
+        }
+
+        /**
+         * Local to world transform of a frame at origin, turned by heading radians
+         */
+        template <typename Math = ExactMath>
+        static constexpr Affine2D rigid(const T heading, const CartesianPoint2D<T>& origin)
+        {
+            Affine2D result { rotation<Math>(heading) };
+            result.matrix[2] = origin.x;
+            result.matrix[5] = origin.y;
+            return result;
+        }
+
+        constexpr CartesianPoint2D<T> operator()(const CartesianPoint2D<T>& p) const
+        {
+            return { matrix[0] * p.x + matrix[1] * p.y + matrix[2],
+                     matrix[3] * p.x + matrix[4] * p.y + matrix[5] };
+        }
+
+        // Without the translation, for directions and velocities
+        [[nodiscard]] constexpr CartesianPoint2D<T> applyLinear(const CartesianPoint2D<T>& v) const
+        {
+            return { matrix[0] * v.x + matrix[1] * v.y,
+                     matrix[3] * v.x + matrix[4] * v.y };
+        }
+
+        // a * b applies b first
+        friend constexpr Affine2D operator*(const Affine2D& a, const Affine2D& b)
+        {
+            const std::array<T, 6>& m { a.matrix };
+            const std::array<T, 6>& n { b.matrix };
+            return { { m[0] * n[0] + m[1] * n[3], m[0] * n[1] + m[1] * n[4], m[0] * n[2] + m[1] * n[5] + m[2],
+                       m[3] * n[0] + m[4] * n[3], m[3] * n[1] + m[4] * n[4], m[3] * n[2] + m[4] * n[5] + m[5] } };
+        }
+
+        // Reads in the order the transforms apply: sensorToVehicle.then(vehicleToWorld)
+        [[nodiscard]] constexpr Affine2D then(const Affine2D& next) const { return next * *this; }
+
+        [[nodiscard]] constexpr T determinant() const { return matrix[0] * matrix[4] - matrix[1] * matrix[3]; }
+
+        // The linear part must be invertible
+        [[nodiscard]] constexpr Affine2D inverse() const
+        {
+            const T det { determinant() };
+            assert(det != 0);
+
+            const T a { matrix[4] / det }, b { -matrix[1] / det };
+            const T c { -matrix[3] / det }, d { matrix[0] / det };
+            return { { a, b, -(a * matrix[2] + b * matrix[5]),
+                       c, d, -(c * matrix[2] + d * matrix[5]) } };
+        }
+
+        [[nodiscard]] constexpr CartesianPoint2D<T> getTranslation() const { return { matrix[2], matrix[5] }; }
+
+        friend constexpr bool operator==(const Affine2D&, const Affine2D&) = default;
+
+        // Row-major: x' = m0 x + m1 y + m2, y' = m3 x + m4 y + m5
+        std::array<T, 6> matrix{ 1, 0, 0,
+                                 0, 1, 0 };
+    };
+
+    template <typename T = double>
+    struct Affine3D
+    {
+        static constexpr Affine3D identity() { return {}; }
+
+        // q must be a unit quaternion
+        static constexpr Affine3D rotation(const Quaternion<T>& q)
+        {
+            const T xx { q.x * q.x }, yy { q.y * q.y }, zz { q.z * q.z };
+            const T xy { q.x * q.y }, xz { q.x * q.z }, yz { q.y * q.z };
+            const T wx { q.w * q.x }, wy { q.w * q.y }, wz { q.w * q.z };
+            return { { 1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy), 0,
+                       2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx), 0,
+                       2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy), 0 } };
+        }
+
+        template <typename Math = ExactMath>
+        static constexpr Affine3D rotation(const CartesianPoint3D<T>& axis, const T angle)
+        {
+            return rotation(Quaternion<T>::template fromAxisAngle<Math>(axis, angle));
+        }
+
+        static constexpr Affine3D translation(const CartesianPoint3D<T>& offset)
+        {
+            return { { 1, 0, 0, offset.x,
+                       0, 1, 0, offset.y,
+                       0, 0, 1, offset.z } };
+        }
+
+        static constexpr Affine3D scaling(const T sx, const T sy, const T sz)
+        {
+            return { { sx, 0, 0, 0,
+                       0, sy, 0, 0,
+                       0, 0, sz, 0 } };
+        }
+
+        /**
+         * Local to world transform of a frame at origin with the orientation q
+         */
+        static constexpr Affine3D rigid(const Quaternion<T>& q, const CartesianPoint3D<T>& origin)
+        {
+            Affine3D result { rotation(q) };
+            result.matrix[3] = origin.x;
+            result.matrix[7] = origin.y;
+            result.matrix[11] = origin.z;
+            return result;
+        }
+
+        constexpr CartesianPoint3D<T> operator()(const CartesianPoint3D<T>& p) const
+        {
+            return applyLinear(p) + getTranslation();
+        }
+
+        // Without the translation, for directions and velocities
+        [[nodiscard]] constexpr CartesianPoint3D<T> applyLinear(const CartesianPoint3D<T>& v) const
+        {
+            return { matrix[0] * v.x + matrix[1] * v.y + matrix[2] * v.z,
+                     matrix[4] * v.x + matrix[5] * v.y + matrix[6] * v.z,
+                     matrix[8] * v.x + matrix[9] * v.y + matrix[10] * v.z };
+        }
+
+        // a * b applies b first
+        friend constexpr Affine3D operator*(const Affine3D& a, const Affine3D& b)
+        {
+            Affine3D result;
+            for (std::size_t row = 0; row < 3; ++row)
+            {
+                const T* m { &a.matrix[4 * row] };
+                for (std::size_t column = 0; column < 4; ++column)
+                {
+                    result.matrix[4 * row + column] = m[0] * b.matrix[column] + m[1] * b.matrix[4 + column]
+                                                    + m[2] * b.matrix[8 + column];
+                }
+                result.matrix[4 * row + 3] += m[3];
+            }
+            return result;
+        }
+
+        // Reads in the order the transforms apply: sensorToVehicle.then(vehicleToWorld)
+        [[nodiscard]] constexpr Affine3D then(const Affine3D& next) const { return next * *this; }
+
+        [[nodiscard]] constexpr T determinant() const
+        {
+            const std::array<T, 12>& m { matrix };
+            return m[0] * (m[5] * m[10] - m[6] * m[9]) - m[1] * (m[4] * m[10] - m[6] * m[8])
+                 + m[2] * (m[4] * m[9] - m[5] * m[8]);
+        }
+
+        // The linear part must be invertible
+        [[nodiscard]] constexpr Affine3D inverse() const
+        {
+            const std::array<T, 12>& m { matrix };
+            const T det { determinant() };
+            assert(det != 0);
+
+            // Adjugate over the determinant
+            Affine3D result { { (m[5] * m[10] - m[6] * m[9]) / det, (m[2] * m[9] - m[1] * m[10]) / det, (m[1] * m[6] - m[2] * m[5]) / det, 0,
+                                (m[6] * m[8] - m[4] * m[10]) / det, (m[0] * m[10] - m[2] * m[8]) / det, (m[2] * m[4] - m[0] * m[6]) / det, 0,
+                                (m[4] * m[9] - m[5] * m[8]) / det, (m[1] * m[8] - m[0] * m[9]) / det, (m[0] * m[5] - m[1] * m[4]) / det, 0 } };
+
+            const CartesianPoint3D<T> t { -result.applyLinear(getTranslation()) };
+            result.matrix[3] = t.x;
+            result.matrix[7] = t.y;
+            result.matrix[11] = t.z;
+            return result;
+        }
+
+        [[nodiscard]] constexpr CartesianPoint3D<T> getTranslation() const { return { matrix[3], matrix[7], matrix[11] }; }
+
+        friend constexpr bool operator==(const Affine3D&, const Affine3D&) = default;
+
+        // Row-major, row r is m[4r] x + m[4r + 1] y + m[4r + 2] z + m[4r + 3]
+        std::array<T, 12> matrix{ 1, 0, 0, 0,
+                                  0, 1, 0, 0,
+                                  0, 0, 1, 0 };
+    };
+}
+
+#endif //COORDSYSTEM_TRANSFORM_H
@@ -0,0 +1,95 @@
+#ifndef COORDSYSTEM_VIEWS_H
+#define COORDSYSTEM_VIEWS_H
+
+#include <ranges>
+
+#include "CoordinateSystems.h"
+#include "Coordinates/Convert.h"
+#include "Coordinates/Distance.h"
+#include "Coordinates/MathPolicy.h"
+
+// Lazy range adaptors over point ranges, named and composed like std::views:
+//   points | Coord::views::to_cartesian | Coord::views::distance_to(ref)
+// Nothing is converted until the view is iterated, and no intermediate container is built.
+namespace Coord::views
+{
+    namespace Detail
+    {
+        template <typename To, typename Math>
+        struct ConvertTo
+        {
+            template <typename From>
+                requires ConvertibleTo<From, To>
+            To operator()(const From& p) const { return convert<To, Math>(p); }
+        };
+
+        template <typename Math>
+        struct ToCartesian
+        {
+            CartesianPoint2D<double> operator()(const PolarPoint& p) const { return convert<CartesianPoint2D<double>, Math>(p); }
+            CartesianPoint2D<double> operator()(const CartesianPoint2D<double>& p) const { return p; }
+            CartesianPoint3D<double> operator()(const SphericalPoint& p) const { return convert<CartesianPoint3D<double>, Math>(p); }
+            CartesianPoint3D<double> operator()(const CylindricalPoint& p) const { return convert<CartesianPoint3D<double>, Math>(p); }
+            CartesianPoint3D<double> operator()(const CartesianPoint3D<double>& p) const { return p; }
+        };
+
+        // Distance in the coordinate system of the reference point
+        template <typename Math>
+        double distance(const CartesianPoint2D<double>& ref, const CartesianPoint2D<double>& p) { return distance2DCartesian<Math>(ref, p); }
+        template <typename Math>
+        double distance(const CartesianPoint3D<double>& ref, const CartesianPoint3D<double>& p) { return distance3DCartesian<Math>(ref, p); }
+        template <typename Math>
+        double distance(const PolarPoint& ref, const PolarPoint& p) { return distance2DPolar<Math>(ref, p); }
+        template <typename Math>
+        double distance(const SphericalPoint& ref, const SphericalPoint& p) { return distance3DChord<Math>(ref, p); }
+
+        template <typename Point, typename Math>
+        struct DistanceTo
+        {
+            Point ref;
+
+            double operator()(const Point& p) const { return distance<Math>(ref, p); }
+        };
+
+        template <typename Point, typename Math>
+        struct Within
+        {
+            Point ref;
+            double radius;
+
+            bool operator()(const Point& p) const { return distance<Math>(ref, p) < radius; }
+        };
+    }
+
+    // Converts every point to To along the path convert<To> would take
+    template <typename To, typename Math = ExactMath>
+    inline constexpr auto convert_to = std::views::transform(Detail::ConvertTo<To, Math>{});
+
+    // Polar -> Cartesian 2D, spherical and cylindrical -> Cartesian 3D, Cartesian points pass through
+    template <typename Math = ExactMath>
+    inline constexpr auto to_cartesian_with = std::views::transform(Detail::ToCartesian<Math>{});
+    inline constexpr auto to_cartesian = to_cartesian_with<ExactMath>;
+
+    inline constexpr auto to_polar = convert_to<PolarPoint>;
+    inline constexpr auto to_spherical = convert_to<SphericalPoint>;
+    inline constexpr auto to_cylindrical = convert_to<CylindricalPoint>;
+
+    /**
+     * Distance from every point to ref, the points have to be of the type of ref.
+     * Spherical points use the chord distance.
+     */
+    template <typename Math = ExactMath, typename Point>
+    auto distance_to(const Point& ref)
+    {
+        return std::views::transform(Detail::DistanceTo<Point, Math>{ ref });
+    }
+
+    // Keeps the points closer than radius to ref
+    template <typename Math = ExactMath, typename Point>
+    auto within(const Point& ref, const double radius)
+    {
+        return std::views::filter(Detail::Within<Point, Math>{ ref, radius });
+    }
+}
+
+#endif //COORDSYSTEM_VIEWS_H
@@ -0,0 +1,12 @@
+#ifndef COORDSYSTEM_CACHELINE_H
+#define COORDSYSTEM_CACHELINE_H
+
+#include <cstddef>
+
+namespace Core
+{
+    // Keeps data written by different threads off each other's cache line
+    inline constexpr std::size_t kCacheLineSize { 64 };
+}
+
+#endif //COORDSYSTEM_CACHELINE_H
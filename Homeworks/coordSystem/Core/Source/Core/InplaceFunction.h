@@ -0,0 +1,129 @@
+#ifndef COORDSYSTEM_INPLACEFUNCTION_H
+#define COORDSYSTEM_INPLACEFUNCTION_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core
+{
+    template <typename Signature, std::size_t Capacity = 32>
+    class InplaceFunction;
+
+    /**
+     * std::function that never allocates. The callable is stored inside the object and must fit in
+     * Capacity bytes, which is checked at compile time. A lambda capturing a few pointers fits the default.
+     */
+    template <typename R, typename... Args, std::size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) {}
+
+        template <typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InplaceFunction(F&& function)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(sizeof(Callable) <= Capacity, "The callable doesn't fit, capture less or raise Capacity");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t));
+            static_assert(std::is_copy_constructible_v<Callable> && std::is_nothrow_move_constructible_v<Callable>);
+
+            ::new (static_cast<void*>(m_storage)) Callable(std::forward<F>(function));
+            m_ops = &kOps<Callable>;
+        }
+
+        InplaceFunction(const InplaceFunction& other)
+        {
+            // Set after the copy, a copy that throws leaves this empty
+            if (other.m_ops)
+                other.m_ops->copy(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+        }
+
+        InplaceFunction(InplaceFunction&& other) noexcept
+            : m_ops{ std::exchange(other.m_ops, nullptr) }
+        {
+            if (m_ops)
+                m_ops->move(m_storage, other.m_storage);
+        }
+
+        InplaceFunction& operator=(const InplaceFunction& other)
+        {
+            if (this != &other)
+            {
+                InplaceFunction copy { other };
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_ops = std::exchange(other.m_ops, nullptr);
+                if (m_ops)
+                    m_ops->move(m_storage, other.m_storage);
+            }
+            return *this;
+        }
+
+        ~InplaceFunction() { reset(); }
+
+        R operator()(Args... args) const
+        {
+            assert(m_ops);
+            return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return m_ops != nullptr; }
+    private:
+        struct Ops
+        {
+            R (*invoke)(void* callable, Args&&... args);
+            void (*copy)(void* to, const void* from);
+            // Leaves from destroyed
+            void (*move)(void* to, void* from) noexcept;
+            void (*destroy)(void* callable) noexcept;
+        };
+
+        template <typename Callable>
+        static constexpr Ops kOps {
+            [](void* callable, Args&&... args) -> R
+            {
+                return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...);
+            },
+            [](void* to, const void* from)
+            {
+                ::new (to) Callable(*static_cast<const Callable*>(from));
+            },
+            [](void* to, void* from) noexcept
+            {
+                ::new (to) Callable(std::move(*static_cast<Callable*>(from)));
+                static_cast<Callable*>(from)->~Callable();
+            },
+            [](void* callable) noexcept
+            {
+                static_cast<Callable*>(callable)->~Callable();
+            }
+        };
+
+        void reset()
+        {
+            if (m_ops)
+                m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    private:
+        // mutable like std::function, operator() is const but the callable may change its state
+        alignas(std::max_align_t) mutable std::byte m_storage[Capacity];
+        const Ops* m_ops{ nullptr };
+    };
+}
+
+#endif //COORDSYSTEM_INPLACEFUNCTION_H
@@ -0,0 +1,119 @@
+#ifndef COORDSYSTEM_SPSCRINGBUFFER_H
+#define COORDSYSTEM_SPSCRINGBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "CacheLine.h"
+
+namespace Core
+{
+    /**
+     * Wait-free queue between exactly one producer thread and one consumer thread, e.g. a network
+     * callback and the render loop. Neither side ever blocks or allocates: TryPush fails when the
+     * queue is full and TryPop when it's empty.
+     *
+     * The slots are preallocated and assigned to, so T must be default constructible.
+     *
+     * @tparam Capacity Power of two
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscRingBuffer
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(std::is_default_constructible_v<T>);
+    public:
+        SpscRingBuffer() = default;
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        // Producer only
+
+        bool TryPush(const T& value) { return TryEmplace(value); }
+        bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+        template <typename U>
+        bool TryEmplace(U&& value)
+        {
+            const std::size_t head { m_head.load(std::memory_order_relaxed) };
+            // The consumer's position is only reloaded when the stale one says the queue is full
+            if (head - m_cachedTail == Capacity)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head - m_cachedTail == Capacity)
+                    return false;
+            }
+
+            m_slots[head & kMask] = std::forward<U>(value);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only
+
+        bool TryPop(T& value)
+        {
+            const std::size_t tail { m_tail.load(std::memory_order_relaxed) };
+            if (tail == m_cachedHead)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail == m_cachedHead)
+                    return false;
+            }
+
+            value = std::move(m_slots[tail & kMask]);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Pops everything that's queued right now and calls consume(T&&) for each item
+         *
+         * @return Number of items consumed
+         */
+        template <typename F>
+        std::size_t ConsumeAll(F&& consume)
+        {
+            const std::size_t tail { m_tail.load(std::memory_order_relaxed) };
+            const std::size_t head { m_head.load(std::memory_order_acquire) };
+            m_cachedHead = head;
+
+            for (std::size_t i = tail; i != head; ++i)
+                consume(std::move(m_slots[i & kMask]));
+
+            // Slots are handed back to the producer all at once
+            m_tail.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        // Either side, only a snapshot while the other one is running
+        [[nodiscard]] std::size_t Size() const
+        {
+            const std::size_t tail { m_tail.load(std::memory_order_acquire) };
+            return m_head.load(std::memory_order_acquire) - tail;
+        }
+
+        [[nodiscard]] bool IsEmpty() const { return Size() == 0; }
+
+        static constexpr std::size_t GetCapacity() { return Capacity; }
+    private:
+        static constexpr std::size_t kMask { Capacity - 1 };
+
+        // Both positions only grow, the slot is position & kMask. head - tail is the size
+        // Written by the producer
+        alignas(kCacheLineSize) std::atomic<std::size_t> m_head{ 0 };
+        std::size_t m_cachedTail{ 0 };
+
+        // Written by the consumer
+        alignas(kCacheLineSize) std::atomic<std::size_t> m_tail{ 0 };
+        std::size_t m_cachedHead{ 0 };
+
+        alignas(kCacheLineSize) std::array<T, Capacity> m_slots{};
+    };
+}
+
+#endif //COORDSYSTEM_SPSCRINGBUFFER_H
@@ -0,0 +1,143 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace Core
+{
+    struct ThreadPool::Job
+    {
+        std::size_t count;
+        std::size_t chunkSize;
+        std::size_t chunkCount;
+        const RangeTask* task;
+
+        std::atomic<std::size_t> nextChunk{ 0 };
+        std::atomic<std::size_t> finishedChunks{ 0 };
+
+        std::mutex mtx;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        m_workers.reserve(threadCount - 1);
+        for (std::size_t i = 1; i < threadCount; ++i)
+            m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    void ThreadPool::ParallelFor(std::size_t count, std::size_t grain, const RangeTask& task, std::size_t maxThreads)
+    {
+        if (count == 0)
+            return;
+
+        if (maxThreads == 0 || maxThreads > GetThreadCount())
+            maxThreads = GetThreadCount();
+
+        grain = std::max(grain, std::size_t{ 1 });
+
+        // A few chunks per thread evens out threads that get descheduled
+        const std::size_t targetChunks { maxThreads * 4 };
+        const std::size_t grainsPerChunk { std::max((count + targetChunks * grain - 1) / (targetChunks * grain), std::size_t{ 1 }) };
+        const std::size_t chunkSize { grainsPerChunk * grain };
+        const std::size_t chunkCount { (count + chunkSize - 1) / chunkSize };
+
+        if (chunkCount == 1 || maxThreads == 1)
+        {
+            task(0, count);
+            return;
+        }
+
+        auto job { std::make_shared<Job>() };
+        job->count = count;
+        job->chunkSize = chunkSize;
+        job->chunkCount = chunkCount;
+        job->task = &task;
+
+        const std::size_t helpers { std::min(maxThreads, chunkCount) - 1 };
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            for (std::size_t i = 0; i < helpers; ++i)
+                m_queue.push_back(job);
+        }
+        m_cv.notify_all();
+
+        RunChunks(*job);
+
+        // Helpers that start after the last chunk was taken only hold the job, they never touch the task
+        std::unique_lock<std::mutex> lock(job->mtx);
+        job->done.wait(lock, [&job] { return job->finishedChunks.load() == job->chunkCount; });
+
+        if (job->error)
+            std::rethrow_exception(job->error);
+    }
+
+    ThreadPool& ThreadPool::Get()
+    {
+        static ThreadPool s_pool;
+        return s_pool;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mtx);
+                m_cv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+                if (m_stopping && m_queue.empty())
+                    return;
+
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            RunChunks(*job);
+        }
+    }
+
+    void ThreadPool::RunChunks(Job& job)
+    {
+        for (std::size_t chunk = job.nextChunk++; chunk < job.chunkCount; chunk = job.nextChunk++)
+        {
+            const std::size_t begin { chunk * job.chunkSize };
+            const std::size_t end { std::min(begin + job.chunkSize, job.count) };
+
+            try
+            {
+                (*job.task)(begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job.mtx);
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+
+            if (job.finishedChunks.fetch_add(1) + 1 == job.chunkCount)
+            {
+                std::lock_guard<std::mutex> lock(job.mtx);
+                job.done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef COORDSYSTEM_THREADPOOL_H
+#define COORDSYSTEM_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+    class ThreadPool
+    {
+    public:
+        using RangeTask = std::function<void(std::size_t begin, std::size_t end)>;
+
+        /**
+         * @param threadCount Threads that work on a ParallelFor, including the calling one. 0 means one per hardware thread
+         */
+        explicit ThreadPool(std::size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * Splits [0, count) into contiguous chunks and calls task(begin, end) for each of them.
+         * The calling thread works on chunks too and returns when all are done.
+         * The first exception thrown by a task is rethrown here.
+         *
+         * @param grain Every chunk except the last one is a multiple of grain elements
+         * @param maxThreads Upper bound on threads used for this call, 0 means all of them
+         */
+        void ParallelFor(std::size_t count, std::size_t grain, const RangeTask& task, std::size_t maxThreads = 0);
+
+        [[nodiscard]] std::size_t GetThreadCount() const { return m_workers.size() + 1; }
+
+        /**
+         * @return Pool shared by the whole application, one thread per hardware thread
+         */
+        static ThreadPool& Get();
+    private:
+        struct Job;
+
+        void WorkerLoop();
+        static void RunChunks(Job& job);
+    private:
+        std::vector<std::thread> m_workers;
+        std::deque<std::shared_ptr<Job>> m_queue;
+        std::mutex m_mtx;
+        std::condition_variable m_cv;
+        bool m_stopping = false;
+    };
+}
+
+#endif //COORDSYSTEM_THREADPOOL_H
@@ -0,0 +1,71 @@
+#ifndef COORDSYSTEM_TRIPLEBUFFER_H
+#define COORDSYSTEM_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "CacheLine.h"
+
+namespace Core
+{
+    /**
+     * Latest snapshot of a value, handed from one writer thread to one reader thread. The writer fills
+     * its own buffer and publishes it, the reader picks up the latest published one. Snapshots published
+     * in between are skipped. Neither side blocks, and buffers are reused, so a T that keeps its capacity
+     * (a vector assigned to) stops allocating once it has grown.
+     */
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() = default;
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // Writer only
+
+        /**
+         * @return Buffer to fill, it still holds whatever snapshot was in it three publishes ago
+         */
+        T& GetWriteBuffer() { return m_buffers[m_back]; }
+
+        // Hands the write buffer to the reader and takes back the one it's not using
+        void Publish()
+        {
+            m_back = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        // Reader only
+
+        /**
+         * Takes the latest published snapshot as read buffer
+         *
+         * @return false if nothing was published since the last call, the read buffer stays the same
+         */
+        bool Update()
+        {
+            if (!(m_middle.load(std::memory_order_relaxed) & kFresh))
+                return false;
+
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+            return true;
+        }
+
+        [[nodiscard]] const T& GetReadBuffer() const { return m_buffers[m_front]; }
+    private:
+        static constexpr std::uint8_t kIndexMask { 0b11 };
+        // Set in m_middle while it holds a snapshot the reader hasn't taken yet
+        static constexpr std::uint8_t kFresh { 0b100 };
+
+        // The three indices are always a permutation of 0, 1, 2
+        alignas(kCacheLineSize) std::uint8_t m_back{ 0 };
+        alignas(kCacheLineSize) std::atomic<std::uint8_t> m_middle{ 1 };
+        alignas(kCacheLineSize) std::uint8_t m_front{ 2 };
+
+        alignas(kCacheLineSize) std::array<T, 3> m_buffers{};
+    };
+}
+
+#endif //COORDSYSTEM_TRIPLEBUFFER_H
@@ -1,9 +1,21 @@
 #include "WebSocketClient.h"
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <random>
 #include <utility>
+#include <vector>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
+#include <boost/asio/co_spawn.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <iostream>
 
 namespace beast = boost::beast;         // from <boost/beast.hpp>
@@ -12,8 +24,320 @@ namespace websocket = beast::websocket; // from <boost/beast/websocket.hpp>
 namespace net = boost::asio;            // from <boost/asio.hpp>
 using tcp = boost::asio::ip::tcp;       // from <boost/asio/ip/tcp.hpp>
 
+struct WebSocketContext::Impl
+{
+    explicit Impl(const std::size_t threadCount)
+        : ioc{ static_cast<int>(threadCount) }, work{ net::make_work_guard(ioc) }
+    {}
+
+    net::io_context ioc;
+    // Keeps run() going while no client is connected
+    net::executor_work_guard<net::io_context::executor_type> work;
+    std::vector<std::thread> threads;
+};
+
+WebSocketContext::WebSocketContext(std::size_t threadCount)
+{
+    threadCount = std::max(threadCount, std::size_t{ 1 });
+    m_impl = std::make_unique<Impl>(threadCount);
+
+    m_impl->threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        m_impl->threads.emplace_back([&ioc = m_impl->ioc] { ioc.run(); });
+}
+
+WebSocketContext::~WebSocketContext()
+{
+    m_impl->work.reset();
+    m_impl->ioc.stop();
+
+    for (std::thread& thread : m_impl->threads)
+        thread.join();
+}
+
+std::size_t WebSocketContext::GetThreadCount() const
+{
+    return m_impl->threads.size();
+}
+
+WebSocketContext& WebSocketContext::Get()
+{
+    static WebSocketContext context{ 2 };
+    return context;
+}
+
+namespace
+{
+    // A flat_buffer is always one contiguous block
+    std::string_view messageView(const beast::flat_buffer& buffer)
+    {
+        return { static_cast<const char*>(buffer.data().data()), buffer.size() };
+    }
+
+    std::string_view trim(std::string_view text)
+    {
+        constexpr std::string_view kWhitespace { " \t\r\n" };
+        const std::size_t first { text.find_first_not_of(kWhitespace) };
+        if (first == std::string_view::npos)
+            return {};
+        return text.substr(first, text.find_last_not_of(kWhitespace) - first + 1);
+    }
+
+    // Top level elements of a JSON array, found by tracking strings and nesting without parsing the values
+    template <typename F>
+    void forEachArrayElement(const std::string_view message, F&& deliver)
+    {
+        const std::string_view array { trim(message) };
+        if (array.empty() || array.front() != '[')
+        {
+            if (!array.empty())
+                deliver(array);
+            return;
+        }
+
+        const auto element = [&](const std::size_t begin, const std::size_t end)
+        {
+            const std::string_view record { trim(array.substr(begin, end - begin)) };
+            if (!record.empty())
+                deliver(record);
+        };
+
+        std::size_t depth { 0 }, begin { 1 };
+        bool inString { false }, escaped { false };
+        for (std::size_t i = 1; i < array.size(); ++i)
+        {
+            const char c { array[i] };
+            if (inString)
+            {
+                if (escaped)
+                    escaped = false;
+                else if (c == '\\')
+                    escaped = true;
+                else if (c == '"')
+                    inString = false;
+                continue;
+            }
+
+            switch (c)
+            {
+                case '"':
+                    inString = true;
+                    break;
+                case '[':
+                case '{':
+                    ++depth;
+                    break;
+                case ']':
+                case '}':
+                    // The bracket that closes the array
+                    if (depth == 0)
+                    {
+                        element(begin, i);
+                        return;
+                    }
+                    --depth;
+                    break;
+                case ',':
+                    if (depth == 0)
+                    {
+                        element(begin, i);
+                        begin = i + 1;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Unterminated array, whatever came after the last comma
+        element(begin, array.size());
+    }
+
+    template <typename F>
+    void forEachLine(std::string_view message, F&& deliver)
+    {
+        while (!message.empty())
+        {
+            const std::size_t end { std::min(message.find('\n'), message.size()) };
+            const std::string_view line { trim(message.substr(0, end)) };
+            if (!line.empty())
+                deliver(line);
+            message.remove_prefix(std::min(end + 1, message.size()));
+        }
+    }
+
+    template <typename F>
+    void forEachRecord(const WebSocketClient::Framing framing, const std::string_view message, F&& deliver)
+    {
+        switch (framing)
+        {
+            case WebSocketClient::Framing::JsonArray:
+                forEachArrayElement(message, deliver);
+                break;
+            case WebSocketClient::Framing::Lines:
+                forEachLine(message, deliver);
+                break;
+            default:
+                deliver(message);
+                break;
+        }
+    }
+}
+
+struct WebSocketClient::Session
+{
+    Session(net::io_context& ioc, const WebSocketClient& client)
+        : strand{ net::make_strand(ioc) }, resolver{ strand }, backoff{ strand }, closeDeadline{ strand },
+          client{ client }, options{ client.m_options }
+    {}
+
+    // Connects, and again after every error unless reconnecting is off. Ends with Stop
+    net::awaitable<void> Run();
+    net::awaitable<void> Connect();
+    // Ends with the error of the read that Stop's close or the server interrupted
+    net::awaitable<void> Read();
+    [[nodiscard]] std::chrono::milliseconds Jitter(std::chrono::milliseconds delay);
+
+    // Everything of the connection runs on the strand, so the coroutine and Stop never touch ws at the same time
+    net::strand<net::io_context::executor_type> strand;
+    tcp::resolver resolver;
+    // A websocket stream can't be reused after an error, every attempt gets a new one
+    std::optional<websocket::stream<beast::tcp_stream>> ws;
+    net::steady_timer backoff;
+    net::steady_timer closeDeadline;
+
+    // Outlives the session, Stop waits for it
+    const WebSocketClient& client;
+    const ConnectionOptions options;
+    std::minstd_rand random{ std::random_device{}() };
+
+    // Only accessed on the strand
+    bool connected{ false };
+    bool stopping{ false };
+
+    std::promise<void> done;
+    std::future<void> finished{ done.get_future() };
+};
+
+net::awaitable<void> WebSocketClient::Session::Run()
+{
+    std::chrono::milliseconds delay { options.reconnectDelay };
+    while (true)
+    {
+        try
+        {
+            co_await Connect();
+            if (stopping)
+                co_return;
+
+            // Only a connection that got through starts the backoff over
+            delay = options.reconnectDelay;
+            co_await Read();
+        }
+        catch (std::exception& e)
+        {
+            if (!stopping)
+            {
+                if (!options.reconnect)
+                    throw;
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        }
+        connected = false;
+        if (stopping)
+            co_return;
+
+        const std::chrono::milliseconds wait { Jitter(delay) };
+        std::cerr << "Reconnecting in " << wait.count() << " ms" << std::endl;
+        backoff.expires_after(wait);
+        // Stop cancels the wait, which must end the session instead of escaping as an exception
+        beast::error_code error;
+        co_await backoff.async_wait(net::redirect_error(net::use_awaitable, error));
+        if (stopping)
+            co_return;
+
+        delay = std::min(delay * 2, options.maxReconnectDelay);
+    }
+}
+
+net::awaitable<void> WebSocketClient::Session::Connect()
+{
+    // Stop cancels only the step in progress, one it came between must not start anymore
+    ws.emplace(strand);
+
+    // Look up the domain name
+    const auto results = co_await resolver.async_resolve(client.m_host, client.m_port, net::use_awaitable);
+    if (stopping)
+        co_return;
+
+    // Make the connection on the IP address we get from a lookup
+    beast::tcp_stream& stream { beast::get_lowest_layer(*ws) };
+    stream.expires_after(options.connectTimeout);
+    co_await stream.async_connect(results, net::use_awaitable);
+    if (stopping)
+        co_return;
+
+    // The websocket stream has timeouts of its own, the one of the tcp_stream would cut quiet connections
+    stream.expires_never();
+    websocket::stream_base::timeout timeout { websocket::stream_base::timeout::suggested(beast::role_type::client) };
+    timeout.handshake_timeout = options.connectTimeout;
+    timeout.idle_timeout = options.idleTimeout.count() > 0 ? options.idleTimeout : websocket::stream_base::none();
+    timeout.keep_alive_pings = options.idleTimeout.count() > 0;
+    ws->set_option(timeout);
+
+    if (options.permessageDeflate)
+    {
+        websocket::permessage_deflate deflate;
+        deflate.client_enable = true;
+        ws->set_option(deflate);
+    }
+
+    // Perform the websocket handshake
+    co_await ws->async_handshake(client.m_host + ":" + client.m_port, "/", net::use_awaitable);
+    if (stopping)
+        co_return;
+    connected = true;
+}
+
+net::awaitable<void> WebSocketClient::Session::Read()
+{
+    // One buffer for all messages, it stops allocating once it has grown to the largest message
+    beast::flat_buffer buffer;
+    while (true)
+    {
+        co_await ws->async_read(buffer, net::use_awaitable);
+        forEachRecord(options.framing, messageView(buffer), [this](const std::string_view record)
+        {
+            // A throwing callback loses its record, not the connection: only I/O errors reconnect
+            try
+            {
+                client.Deliver(record);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "Message callback error: " << e.what() << std::endl;
+            }
+        });
+        buffer.clear();
+    }
+}
+
+std::chrono::milliseconds WebSocketClient::Session::Jitter(const std::chrono::milliseconds delay)
+{
+    const std::chrono::milliseconds::rep half { delay.count() / 2 };
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution { 0, delay.count() - half };
+    return std::chrono::milliseconds{ half + distribution(random) };
+}
+
 WebSocketClient::WebSocketClient(std::string host, std::string port, const std::function<void(const std::string&)>& messageFunction)
-    : m_host{ std::move(host) }, m_port{ std::move(port) }, m_messageFunction{ messageFunction }
+    : m_host{ std::move(host) }, m_port{ std::move(port) }, m_ownContext{ std::make_unique<WebSocketContext>(1) },
+      m_context{ m_ownContext.get() }, m_messageFunction{ messageFunction }
+{
+}
+
+WebSocketClient::WebSocketClient(WebSocketContext& context, std::string host, std::string port,
+                                 const std::function<void(const std::string&)>& messageFunction)
+    : m_host{ std::move(host) }, m_port{ std::move(port) }, m_context{ &context }, m_messageFunction{ messageFunction }
 {
 }
 
@@ -26,20 +350,15 @@ void WebSocketClient::Start()
 {
     if(!is_running)
     {
-        if (m_thread.joinable())
-            m_thread.join();
-
-        is_running = true;
-        m_thread = std::thread(&WebSocketClient::Run, this);
+        // A session that ended on its own
+        StopSession();
+        StartSession();
     }
 }
 
 void WebSocketClient::Stop()
 {
-    is_running.store(false);
-
-    if (m_thread.joinable())
-        m_thread.join();
+    StopSession();
 }
 
 // std::string WebSocketClient::GetMessage() const
@@ -48,45 +367,75 @@ void WebSocketClient::Stop()
 //     return m_message;
 // }
 
-void WebSocketClient::Run()
+void WebSocketClient::Deliver(const std::string_view message) const
 {
-    try
-    {
-        // The io_context is required for all I/O
-        net::io_context ioc;
+    if (m_messageViewFunction)
+        m_messageViewFunction(message);
+    else
+        m_messageFunction(std::string{ message });
+}
+
+void WebSocketClient::StartSession()
+{
+    m_session = std::make_shared<Session>(m_context->m_impl->ioc, *this);
+    is_running = true;
 
-        // These objects perform our I/O
-        tcp::resolver resolver{ioc};
-        websocket::stream<tcp::socket> ws{ioc};
+    net::co_spawn(m_session->strand, m_session->Run(), [this, session = m_session](const std::exception_ptr& error)
+    {
+        if (session->stopping)
+            std::cout << "Websocket stopped\n";
+        else if (error)
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        }
 
-        // Look up the domain name
-        auto const results = resolver.resolve(m_host, m_port);
+        // Stop may have armed it, nothing is left to close
+        session->closeDeadline.cancel();
 
-        // Make the connection on the IP address we get from a lookup
-        net::connect(ws.next_layer(), results);
+        // Last use of this, StopSession may return and the client be destroyed right after
+        is_running = false;
+        session->done.set_value();
+    });
+}
 
-        // Perform the websocket handshake
-        ws.handshake(m_host + ":" + m_port, "/");
+void WebSocketClient::StopSession()
+{
+    if (!m_session)
+        return;
 
-        is_running = true;
+    net::post(m_session->strand, [session = m_session]
+    {
+        session->stopping = true;
 
-        // Continuous read loop
-        while (is_running.load())
+        // Closing makes the pending read fail. Until the handshake is done there's no websocket to close yet
+        if (session->connected)
         {
-            beast::flat_buffer buffer;
-            ws.read(buffer);
-            std::string msg = beast::buffers_to_string(buffer.data());
-            m_messageFunction(msg);
+            session->ws->async_close(websocket::close_code::normal, [session](beast::error_code) {});
 
+            // A server that doesn't answer the close gets the socket shut instead
+            session->closeDeadline.expires_after(session->options.closeTimeout);
+            session->closeDeadline.async_wait([session](const beast::error_code& error)
+            {
+                if (!error && session->ws)
+                    beast::get_lowest_layer(*session->ws).close();
+            });
         }
+        else
+        {
+            session->resolver.cancel();
+            session->backoff.cancel();
+            if (session->ws)
+                beast::get_lowest_layer(*session->ws).cancel();
+        }
+    });
 
-        ws.close(websocket::close_code::normal);
-        std::cout << "Websocket stopped\n";
-    }
-    catch(std::exception& e)
-    {
-        std::cerr << "Error: " << e.what() << std::endl;
-    }
-
-    is_running = false;
-}
\ No newline at end of file
+    m_session->finished.wait();
+    m_session.reset();
+}
@@ -2,38 +2,155 @@
 #define LB2_WEBSOCKETCLIENT_H
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <thread>
+#include <memory>
 #include <mutex>
 #include <list>
 #include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include "Core/InplaceFunction.h"
+
+/**
+ * io_context and the threads that run it, shared by any number of clients in async mode.
+ * A few threads serve dozens of connections since every client only needs a thread while
+ * a message of it is handled.
+ */
+class WebSocketContext
+{
+public:
+    /**
+     * @param threadCount Threads that run the connections and message callbacks of all clients, at least 1
+     */
+    explicit WebSocketContext(std::size_t threadCount = 1);
+    // Clients on this context must be stopped or destroyed before
+    ~WebSocketContext();
+
+    WebSocketContext(const WebSocketContext&) = delete;
+    WebSocketContext& operator=(const WebSocketContext&) = delete;
+
+    [[nodiscard]] std::size_t GetThreadCount() const;
+
+    /**
+     * @return Context shared by the whole application, two threads
+     */
+    static WebSocketContext& Get();
+private:
+    friend class WebSocketClient;
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
 
 class WebSocketClient
 {
 public:
     /**
+     * Callback of the zero-copy delivery mode. The view points into the connection's read buffer, which is
+     * reused for the next message, so it's only valid during the call. Copy what has to be kept
+     */
+    using MessageViewFunction = Core::InplaceFunction<void(std::string_view)>;
+
+    // How records are packed into the messages of the server. Each record is delivered on its own
+    enum class Framing
+    {
+        // One record per message
+        Message,
+        // A message is a JSON array, every element is a record. A message that isn't an array is one record
+        JsonArray,
+        // Records separated by newlines (NDJSON), empty lines are skipped
+        Lines
+    };
+
+    struct ConnectionOptions
+    {
+        // TCP connect and websocket handshake, each
+        std::chrono::milliseconds connectTimeout{ 5000 };
+        // A connection that got nothing for this long, not even a pong to the pings sent at half of it, is dropped. 0 disables
+        std::chrono::milliseconds idleTimeout{ 10000 };
+        // How long Stop waits for the server to answer the close before the socket is shut
+        std::chrono::milliseconds closeTimeout{ 1000 };
+
+        // Connect again after an error instead of stopping
+        bool reconnect{ true };
+        // The wait doubles with every failed attempt up to maxReconnectDelay, a connection that gets through
+        // resets it. Each wait is randomly between half and all of it, so clients don't retry in lockstep
+        std::chrono::milliseconds reconnectDelay{ 250 };
+        std::chrono::milliseconds maxReconnectDelay{ 10000 };
+
+        // Offers permessage-deflate in the handshake, messages are compressed if the server accepts it
+        bool permessageDeflate{ false };
+        // Records are views into the message like with MessageViewFunction, splitting copies nothing
+        Framing framing{ Framing::Message };
+    };
+public:
+    /**
+     * Blocking mode, the connection runs on a thread of its own
      *
      * @param host IP address of the websocket server
      * @param port Port that server uses
-     * @param messageFunction Function that's being called during getting a message
+     * @param messageFunction Function that's being called during getting a message. Exceptions it throws
+     *        are logged and drop that message, the connection stays up
      */
     WebSocketClient(std::string host, std::string port, const std::function<void(const std::string&)>& messageFunction);
+
+    /**
+     * Async mode, the connection is a coroutine on context. messageFunction runs on a thread of the context,
+     * never concurrently with itself but possibly at the same time as the callbacks of other clients
+     */
+    WebSocketClient(WebSocketContext& context, std::string host, std::string port,
+                    const std::function<void(const std::string&)>& messageFunction);
+
+    // Zero-copy delivery, see MessageViewFunction. Picked for callables that take a std::string_view
+
+    template <typename F> requires std::is_invocable_v<F&, std::string_view>
+    WebSocketClient(std::string host, std::string port, F&& messageFunction)
+        : m_host{ std::move(host) }, m_port{ std::move(port) }, m_ownContext{ std::make_unique<WebSocketContext>(1) },
+          m_context{ m_ownContext.get() }, m_messageViewFunction{ std::forward<F>(messageFunction) }
+    {}
+
+    template <typename F> requires std::is_invocable_v<F&, std::string_view>
+    WebSocketClient(WebSocketContext& context, std::string host, std::string port, F&& messageFunction)
+        : m_host{ std::move(host) }, m_port{ std::move(port) }, m_context{ &context },
+          m_messageViewFunction{ std::forward<F>(messageFunction) }
+    {}
+
     ~WebSocketClient();
 
     void Start();
+    // Returns within about closeTimeout, whatever state the connection is in. Must not be called from messageFunction
     void Stop();
 
+    // Used from the next Start on
+    void SetOptions(const ConnectionOptions& options) { m_options = options; }
+    [[nodiscard]] const ConnectionOptions& GetOptions() const { return m_options; }
+
     // [[nodiscard]] std::string GetMessage() const;
     [[nodiscard]] bool IsRunning() const { return is_running.load(); }
 private:
-    void Run();
+    // Hands a message to whichever callback the client was made with
+    void Deliver(std::string_view message) const;
+
+    // Connection state of async mode, shared with the coroutine that runs it
+    struct Session;
+    void StartSession();
+    void StopSession();
 
 private:
     std::string m_host, m_port;
-    std::thread m_thread;
+    ConnectionOptions m_options;
+    // Blocking mode runs on a context of its own with one thread
+    std::unique_ptr<WebSocketContext> m_ownContext;
+    WebSocketContext* m_context{ nullptr };
+    std::shared_ptr<Session> m_session;
     // mutable std::mutex m_mtx;
     std::atomic_bool is_running{ false };
     std::function<void(const std::string&)> m_messageFunction;
+    MessageViewFunction m_messageViewFunction;
     // std::string m_message;
 };
 
-#endif //LB2_WEBSOCKETCLIENT_H
\ No newline at end of file
+#endif //LB2_WEBSOCKETCLIENT_H